@@ -0,0 +1,129 @@
+#pragma once
+
+/**
+ * @file BenchData.hpp
+ * @brief Input generators shared by the dsa_bench benchmarks
+ * @author Neel Patel
+ * @version 1.0.0
+ *
+ * Every input is derived from a uint64_t sequence in one of five
+ * distributions and converted to the element type with an order-preserving
+ * makeKey<T>, so "sorted" stays sorted for every type.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifndef DSA_BENCH_MAX_SIZE
+#define DSA_BENCH_MAX_SIZE 1000000
+#endif
+
+namespace bench {
+
+inline constexpr int64_t kMinSize = 100;
+inline constexpr int64_t kMaxSize = DSA_BENCH_MAX_SIZE;
+inline constexpr int64_t kQuadraticMaxSize = 10000; // bubble / selection / insertion sort
+
+// 64-byte record ordered by its key
+struct Record {
+    uint64_t key;
+    char payload[56];
+    
+    friend bool operator<(const Record& a, const Record& b) { return a.key < b.key; }
+};
+
+static_assert(sizeof(Record) == 64, "Record should fill one cache line");
+
+enum class Distribution { Random, Sorted, Reversed, FewUnique, OrganPipe };
+
+inline constexpr Distribution kDistributions[] = {
+    Distribution::Random, Distribution::Sorted, Distribution::Reversed,
+    Distribution::FewUnique, Distribution::OrganPipe,
+};
+
+inline const char* distributionName(Distribution d) {
+    switch (d) {
+        case Distribution::Random: return "random";
+        case Distribution::Sorted: return "sorted";
+        case Distribution::Reversed: return "reversed";
+        case Distribution::FewUnique: return "few_unique";
+        case Distribution::OrganPipe: return "organ_pipe";
+    }
+    return "?";
+}
+
+// Order-preserving conversion from a generated value
+template <typename T>
+T makeKey(uint64_t v);
+
+template <>
+inline int makeKey<int>(uint64_t v) { return static_cast<int>(v & 0x7fffffff); }
+
+template <>
+inline double makeKey<double>(uint64_t v) { return static_cast<double>(v); }
+
+template <>
+inline std::string makeKey<std::string>(uint64_t v) {
+    char buf[24];
+    std::snprintf(buf, sizeof(buf), "%020llu", static_cast<unsigned long long>(v));
+    return buf;
+}
+
+template <>
+inline Record makeKey<Record>(uint64_t v) {
+    Record r{};
+    r.key = v;
+    return r;
+}
+
+template <typename T> constexpr const char* typeName();
+template <> constexpr const char* typeName<int>() { return "int"; }
+template <> constexpr const char* typeName<double>() { return "double"; }
+template <> constexpr const char* typeName<std::string>() { return "string"; }
+template <> constexpr const char* typeName<Record>() { return "record64"; }
+
+// n values in the given distribution; the same (n, d) always yields the same input
+template <typename T>
+std::vector<T> makeInput(size_t n, Distribution d, uint64_t seed = 42) {
+    std::mt19937_64 rng(seed);
+    std::vector<T> out;
+    out.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t v;
+        switch (d) {
+            case Distribution::Random: v = rng() >> 2; break;
+            case Distribution::Sorted: v = i; break;
+            case Distribution::Reversed: v = n - i; break;
+            case Distribution::FewUnique: v = rng() % 16; break;
+            case Distribution::OrganPipe: v = i < n / 2 ? i : n - i; break;
+            default: v = 0; break;
+        }
+        out.push_back(makeKey<T>(v));
+    }
+    return out;
+}
+
+// Distinct random keys, for the containers
+template <typename T>
+std::vector<T> makeDistinctKeys(size_t n, uint64_t seed = 7) {
+    std::vector<uint64_t> values(n);
+    for (size_t i = 0; i < n; ++i) values[i] = i * 2 + 1; // odd: even probes miss
+    std::shuffle(values.begin(), values.end(), std::mt19937_64(seed));
+    std::vector<T> out;
+    out.reserve(n);
+    for (uint64_t v : values) out.push_back(makeKey<T>(v));
+    return out;
+}
+
+// Largest size worth sweeping for T: caps inputs at about 1 GiB
+template <typename T>
+constexpr int64_t maxSizeFor() {
+    return std::min<int64_t>(kMaxSize, (int64_t(1) << 30) / static_cast<int64_t>(sizeof(T) * 2));
+}
+
+} // namespace bench
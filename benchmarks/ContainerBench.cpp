@@ -0,0 +1,270 @@
+/**
+ * @file ContainerBench.cpp
+ * @brief dsa containers against their std:: equivalents
+ * @author Neel Patel
+ * @version 1.0.0
+ *
+ * Benchmarks are named <container>/<operation>/<n>:
+ * - lists (LinkedList, List, UnrolledList, IndexedList vs std::forward_list,
+ *   std::list): push_back, iterate, contains, sort
+ * - ordered sets (BinarySearchTree, BalancedTree, PersistentSearchTree,
+ *   ConcurrentSearchTree, StaticSearchTree vs std::set): insert, find,
+ *   erase, iterate
+ * - ConcurrentQueue vs std::queue: push then pop, single-threaded
+ *
+ * Keys are distinct and shuffled; lookups hit and miss alternately. The
+ * unbalanced BinarySearchTree gets shuffled keys only, so it stays O(log n).
+ */
+
+#include "BenchData.hpp"
+
+#include "dsa/BinarySearchTree.hpp"
+#include "dsa/ConcurrentQueue.hpp"
+#include "dsa/ConcurrentSearchTree.hpp"
+#include "dsa/IndexedList.hpp"
+#include "dsa/LinkedList.hpp"
+#include "dsa/List.hpp"
+#include "dsa/PersistentSearchTree.hpp"
+#include "dsa/StaticSearchTree.hpp"
+#include "dsa/UnrolledList.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <forward_list>
+#include <list>
+#include <queue>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+using Key = int;
+
+constexpr int64_t kListMaxSize = std::min<int64_t>(bench::kMaxSize, 1000000);
+constexpr int64_t kScanMaxSize = std::min<int64_t>(bench::kMaxSize, 100000);
+
+// Probes: the stored (odd) keys and absent even neighbours, alternately
+std::vector<Key> makeProbes(const std::vector<Key>& keys) {
+    std::vector<Key> probes;
+    probes.reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) probes.push_back(i % 2 ? keys[i] - 1 : keys[i]);
+    return probes;
+}
+
+// Adapters: one spelling of each operation per container
+
+template <typename L> void listPush(L& l, Key k) { l.push_back(k); }
+template <typename U> void listPush(std::forward_list<Key, U>& l, Key k) { l.push_front(k); }
+
+template <typename L> bool listContains(const L& l, Key k) { return l.contains(k); }
+template <typename U> bool listContains(const std::forward_list<Key, U>& l, Key k) {
+    return std::find(l.begin(), l.end(), k) != l.end();
+}
+template <typename U> bool listContains(const std::list<Key, U>& l, Key k) {
+    return std::find(l.begin(), l.end(), k) != l.end();
+}
+
+template <typename S> void setInsert(S& s, Key k) { s.insert(k); }
+
+template <typename S> bool setContains(const S& s, Key k) { return s.contains(k); }
+template <typename C, typename A> bool setContains(const std::set<Key, C, A>& s, Key k) {
+    return s.find(k) != s.end();
+}
+
+template <typename S> void setErase(S& s, Key k) { s.remove(k); }
+template <typename C, typename A> void setErase(std::set<Key, C, A>& s, Key k) { s.erase(k); }
+
+// Lists
+
+template <typename L>
+void BM_ListPushBack(benchmark::State& state) {
+    std::vector<Key> keys = bench::makeDistinctKeys<Key>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        L list;
+        for (Key k : keys) listPush(list, k);
+        benchmark::DoNotOptimize(list);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename L>
+void BM_ListIterate(benchmark::State& state) {
+    L list;
+    for (Key k : bench::makeDistinctKeys<Key>(static_cast<size_t>(state.range(0)))) listPush(list, k);
+    for (auto _ : state) {
+        int64_t sum = 0;
+        for (Key k : list) sum += k;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Linear search for 64 probes
+template <typename L>
+void BM_ListContains(benchmark::State& state) {
+    std::vector<Key> keys = bench::makeDistinctKeys<Key>(static_cast<size_t>(state.range(0)));
+    L list;
+    for (Key k : keys) listPush(list, k);
+    std::vector<Key> probes = makeProbes(keys);
+    probes.resize(std::min<size_t>(probes.size(), 64));
+    for (auto _ : state) {
+        size_t hits = 0;
+        for (Key k : probes) hits += listContains(list, k);
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(probes.size()));
+}
+
+// Rebuild from shuffled keys each iteration (untimed), then sort in place
+template <typename L>
+void BM_ListSort(benchmark::State& state) {
+    std::vector<Key> keys = bench::makeDistinctKeys<Key>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        state.PauseTiming();
+        L list;
+        for (Key k : keys) listPush(list, k);
+        state.ResumeTiming();
+        list.sort();
+        benchmark::DoNotOptimize(list);
+        state.PauseTiming();
+        list = L();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Ordered sets
+
+template <typename S>
+void BM_SetInsert(benchmark::State& state) {
+    std::vector<Key> keys = bench::makeDistinctKeys<Key>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        S set;
+        for (Key k : keys) setInsert(set, k);
+        benchmark::DoNotOptimize(set);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Fill an empty set (ConcurrentSearchTree cannot be moved, so no factory)
+template <typename S>
+void fillSet(S& set, const std::vector<Key>& keys) {
+    if constexpr (std::is_same_v<S, dsa::StaticSearchTree<Key>>) {
+        set = S(keys);
+    } else {
+        for (Key k : keys) setInsert(set, k);
+    }
+}
+
+template <typename S>
+void BM_SetFind(benchmark::State& state) {
+    std::vector<Key> keys = bench::makeDistinctKeys<Key>(static_cast<size_t>(state.range(0)));
+    S set;
+    fillSet(set, keys);
+    std::vector<Key> probes = makeProbes(keys);
+    for (auto _ : state) {
+        size_t hits = 0;
+        for (Key k : probes) hits += setContains(set, k);
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(probes.size()));
+}
+
+// Build (untimed), then erase every key in shuffled order
+template <typename S>
+void BM_SetErase(benchmark::State& state) {
+    std::vector<Key> keys = bench::makeDistinctKeys<Key>(static_cast<size_t>(state.range(0)));
+    std::vector<Key> order = bench::makeDistinctKeys<Key>(keys.size(), 11);
+    for (auto _ : state) {
+        state.PauseTiming();
+        S set;
+        fillSet(set, keys);
+        state.ResumeTiming();
+        for (Key k : order) setErase(set, k);
+        benchmark::DoNotOptimize(set);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename S>
+void BM_SetIterate(benchmark::State& state) {
+    S set;
+    fillSet(set, bench::makeDistinctKeys<Key>(static_cast<size_t>(state.range(0))));
+    for (auto _ : state) {
+        int64_t sum = 0;
+        for (Key k : set) sum += k;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Queues
+
+template <typename Q>
+void BM_QueuePushPop(benchmark::State& state) {
+    int64_t n = state.range(0);
+    Q queue;
+    for (auto _ : state) {
+        for (int64_t i = 0; i < n; ++i) queue.push(static_cast<Key>(i));
+        int64_t sum = 0;
+        if constexpr (std::is_same_v<Q, std::queue<Key>>) {
+            for (; !queue.empty(); queue.pop()) sum += queue.front();
+        } else {
+            for (Key k; queue.try_pop(k);) sum += k;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename Fn>
+void add(const std::string& name, int64_t maxSize, Fn fn) {
+    benchmark::RegisterBenchmark(name.c_str(), fn)
+        ->RangeMultiplier(10)
+        ->Range(bench::kMinSize, maxSize)
+        ->Unit(benchmark::kMicrosecond);
+}
+
+template <typename L, bool Sortable = true>
+void registerList(const std::string& name) {
+    add(name + "/push_back", kListMaxSize, BM_ListPushBack<L>);
+    add(name + "/iterate", kListMaxSize, BM_ListIterate<L>);
+    add(name + "/contains", kScanMaxSize, BM_ListContains<L>);
+    if constexpr (Sortable) add(name + "/sort", kListMaxSize, BM_ListSort<L>);
+}
+
+template <typename S, bool Mutable = true, bool Iterable = true>
+void registerSet(const std::string& name) {
+    if constexpr (Mutable) add(name + "/insert", bench::kMaxSize, BM_SetInsert<S>);
+    add(name + "/find", bench::kMaxSize, BM_SetFind<S>);
+    if constexpr (Mutable) add(name + "/erase", bench::kMaxSize, BM_SetErase<S>);
+    if constexpr (Iterable) add(name + "/iterate", bench::kMaxSize, BM_SetIterate<S>);
+}
+
+const bool registered = [] {
+    // dsa::List, dsa::UnrolledList and dsa::IndexedList have no sort()
+    registerList<std::forward_list<Key>>("std::forward_list");
+    registerList<std::list<Key>>("std::list");
+    registerList<dsa::LinkedList<Key>>("dsa::LinkedList");
+    registerList<dsa::List<Key>, false>("dsa::List");
+    registerList<dsa::UnrolledList<Key>, false>("dsa::UnrolledList");
+    registerList<dsa::IndexedList<Key>, false>("dsa::IndexedList");
+    
+    // ConcurrentSearchTree has no iterators; StaticSearchTree is read-only
+    registerSet<std::set<Key>>("std::set");
+    registerSet<dsa::BinarySearchTree<Key>>("dsa::BinarySearchTree");
+    registerSet<dsa::BalancedTree<Key>>("dsa::BalancedTree");
+    registerSet<dsa::PersistentSearchTree<Key>>("dsa::PersistentSearchTree");
+    registerSet<dsa::ConcurrentSearchTree<Key>, true, false>("dsa::ConcurrentSearchTree");
+    registerSet<dsa::StaticSearchTree<Key>, false>("dsa::StaticSearchTree");
+    
+    add("std::queue/push_pop", kListMaxSize, BM_QueuePushPop<std::queue<Key>>);
+    add("dsa::ConcurrentQueue/push_pop", kListMaxSize, BM_QueuePushPop<dsa::ConcurrentQueue<Key>>);
+    return true;
+}();
+
+} // namespace
@@ -0,0 +1,259 @@
+/**
+ * @file SortBench.cpp
+ * @brief dsa::sort algorithms against std::sort / std::stable_sort
+ * @author Neel Patel
+ * @version 1.0.0
+ *
+ * Benchmarks are named sort/<algorithm>/<type>/<distribution>/<n>, with n
+ * from 1e2 up to DSA_BENCH_MAX_SIZE in powers of ten (1e4 for the quadratic
+ * sorts). Each iteration restores the unsorted input into a preallocated
+ * buffer inside the timed region; every algorithm, the std:: baselines
+ * included, pays the same copy.
+ *
+ * argSort + applyPermutation and sortByKey (with a row-id payload column)
+ * are timed as sorts, the column restore included. externalSort runs file
+ * to file with a 1 MiB memory budget, so inputs beyond that spill runs;
+ * it covers the trivially copyable types only.
+ *
+ * select/<algorithm>/<type>/<distribution>/<n>/<k> selects the k smallest
+ * of n with nthElement, partialSort and topK against std::nth_element and
+ * std::partial_sort, for k = 10, 1000 and n / 2 (topK only at k = 10 and
+ * 1000, its compile-time sizes).
+ *
+ * small_sort/<algorithm>/<type>/<N> sorts 4096 random std::array<T, N>
+ * batches per iteration. staticSort only takes sizes known at compile
+ * time, so it is benchmarked here and not on the runtime-sized inputs.
+ */
+
+#include "BenchData.hpp"
+
+#include "dsa/ArgSort.hpp"
+#include "dsa/ExternalSort.hpp"
+#include "dsa/ParallelSort.hpp"
+#include "dsa/RadixSort.hpp"
+#include "dsa/Selection.hpp"
+#include "dsa/Sorting.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+using bench::Distribution;
+using bench::Record;
+
+template <typename T, typename Sort>
+void registerSort(const char* algorithm, int64_t maxSize, Sort sort) {
+    for (Distribution d : bench::kDistributions) {
+        std::string name = std::string("sort/") + algorithm + "/" + bench::typeName<T>() + "/" +
+                           bench::distributionName(d);
+        benchmark::RegisterBenchmark(name.c_str(), [d, sort](benchmark::State& state) {
+            size_t n = static_cast<size_t>(state.range(0));
+            const std::vector<T> input = bench::makeInput<T>(n, d);
+            std::vector<T> data(input);
+            for (auto _ : state) {
+                std::copy(input.begin(), input.end(), data.begin());
+                sort(data);
+                benchmark::DoNotOptimize(data.data());
+                benchmark::ClobberMemory();
+            }
+            state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+        })
+            ->RangeMultiplier(10)
+            ->Range(bench::kMinSize, std::min(maxSize, bench::maxSizeFor<T>()))
+            ->Unit(benchmark::kMicrosecond);
+    }
+}
+
+// File to file; the input file is written once, outside the timed loop
+template <typename T>
+void registerExternalSort() {
+    for (Distribution d : bench::kDistributions) {
+        std::string name = std::string("sort/externalSort/") + bench::typeName<T>() + "/" +
+                           bench::distributionName(d);
+        benchmark::RegisterBenchmark(name.c_str(), [d](benchmark::State& state) {
+            size_t n = static_cast<size_t>(state.range(0));
+            const std::filesystem::path dir = std::filesystem::temp_directory_path();
+            const std::filesystem::path input = dir / "dsa_bench_external.in";
+            const std::filesystem::path output = dir / "dsa_bench_external.out";
+            {
+                const std::vector<T> values = bench::makeInput<T>(n, d);
+                std::ofstream out(input, std::ios::binary | std::ios::trunc);
+                out.write(reinterpret_cast<const char*>(values.data()),
+                          static_cast<std::streamsize>(values.size() * sizeof(T)));
+            }
+            dsa::sort::ExternalSortOptions options;
+            options.memoryBudget = size_t(1) << 20;
+            for (auto _ : state) {
+                dsa::sort::externalSort<T>(input, output, std::less<T>(), options);
+                benchmark::ClobberMemory();
+            }
+            std::filesystem::remove(input);
+            std::filesystem::remove(output);
+            state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+        })
+            ->RangeMultiplier(10)
+            ->Range(bench::kMinSize, bench::maxSizeFor<T>())
+            ->Unit(benchmark::kMicrosecond);
+    }
+}
+
+// Key for radixSort: the value itself, or the key of a Record
+struct RadixKey {
+    template <typename T>
+    const T& operator()(const T& value) const { return value; }
+    uint64_t operator()(const Record& r) const { return r.key; }
+};
+
+template <typename T>
+void registerSorts() {
+    using Vec = std::vector<T>;
+    const int64_t all = bench::kMaxSize;
+    const int64_t quadratic = bench::kQuadraticMaxSize;
+    
+    registerSort<T>("std_sort", all, [](Vec& v) { std::sort(v.begin(), v.end()); });
+    registerSort<T>("std_stable_sort", all, [](Vec& v) { std::stable_sort(v.begin(), v.end()); });
+    
+    registerSort<T>("bubbleSort", quadratic, [](Vec& v) { dsa::sort::bubbleSort(v); });
+    registerSort<T>("selectionSort", quadratic, [](Vec& v) { dsa::sort::selectionSort(v); });
+    registerSort<T>("insertionSort", quadratic, [](Vec& v) { dsa::sort::insertionSort(v); });
+    registerSort<T>("mergeSort", all, [](Vec& v) { dsa::sort::mergeSort(v); });
+    registerSort<T>("bottomUpMergeSort", all, [](Vec& v) { dsa::sort::bottomUpMergeSort(v); });
+    registerSort<T>("naturalMergeSort", all, [](Vec& v) { dsa::sort::naturalMergeSort(v); });
+    registerSort<T>("heapSort", all, [](Vec& v) { dsa::sort::heapSort(v); });
+    registerSort<T>("introSort", all, [](Vec& v) { dsa::sort::introSort(v); });
+    registerSort<T>("quickSort", all, [](Vec& v) { dsa::sort::quickSort(v); });
+    registerSort<T>("radixSort", all, [](Vec& v) { dsa::sort::radixSort(v, RadixKey()); });
+    
+    registerSort<T>("mergeSort_par", all, [](Vec& v) { dsa::sort::mergeSort(dsa::execution::par, v); });
+    registerSort<T>("quickSort_par", all, [](Vec& v) { dsa::sort::quickSort(dsa::execution::par, v); });
+    
+    registerSort<T>("argSort_applyPermutation", all, [](Vec& v) {
+        dsa::sort::applyPermutation(dsa::sort::argSort(v), v);
+    });
+    // Row ids as the payload column, renumbered every iteration
+    auto rows = std::make_shared<std::vector<uint32_t>>();
+    registerSort<T>("sortByKey", all, [rows](Vec& v) {
+        rows->resize(v.size());
+        std::iota(rows->begin(), rows->end(), 0u);
+        dsa::sort::sortByKey(v, *rows);
+    });
+    
+    if constexpr (std::is_trivially_copyable_v<T>) registerExternalSort<T>();
+}
+
+// The k smallest of n, for each k in ks below n (and n / 2 with median)
+template <typename T, typename Select>
+void registerSelect(const char* algorithm, std::initializer_list<int64_t> ks, bool median, Select select) {
+    for (Distribution d : bench::kDistributions) {
+        std::string name = std::string("select/") + algorithm + "/" + bench::typeName<T>() + "/" +
+                           bench::distributionName(d);
+        auto* b = benchmark::RegisterBenchmark(name.c_str(), [d, select](benchmark::State& state) {
+            size_t n = static_cast<size_t>(state.range(0));
+            size_t k = static_cast<size_t>(state.range(1));
+            const std::vector<T> input = bench::makeInput<T>(n, d);
+            std::vector<T> data(input);
+            for (auto _ : state) {
+                std::copy(input.begin(), input.end(), data.begin());
+                select(data, k);
+                benchmark::DoNotOptimize(data.data());
+                benchmark::ClobberMemory();
+            }
+            state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+        });
+        for (int64_t n = bench::kMinSize; n <= bench::maxSizeFor<T>(); n *= 10) {
+            for (int64_t k : ks) {
+                if (k < n) b->Args({n, k});
+            }
+            if (median) b->Args({n, n / 2});
+        }
+        b->Unit(benchmark::kMicrosecond);
+    }
+}
+
+template <typename T>
+void registerSelects() {
+    using Vec = std::vector<T>;
+    
+    registerSelect<T>("std_nth_element", {10, 1000}, true, [](Vec& v, size_t k) {
+        std::nth_element(v.begin(), v.begin() + k, v.end());
+    });
+    registerSelect<T>("std_partial_sort", {10, 1000}, true, [](Vec& v, size_t k) {
+        std::partial_sort(v.begin(), v.begin() + k, v.end());
+    });
+    registerSelect<T>("nthElement", {10, 1000}, true, [](Vec& v, size_t k) { dsa::sort::nthElement(v, k); });
+    registerSelect<T>("partialSort", {10, 1000}, true, [](Vec& v, size_t k) { dsa::sort::partialSort(v, k); });
+    registerSelect<T>("topK", {10}, false, [](Vec& v, size_t) {
+        benchmark::DoNotOptimize(dsa::sort::topK<10>(v));
+    });
+    registerSelect<T>("topK", {1000}, false, [](Vec& v, size_t) {
+        benchmark::DoNotOptimize(dsa::sort::topK<1000>(v));
+    });
+}
+
+// Many small fixed-size arrays, as in batched sorting
+template <typename T, size_t N, typename Sort>
+void registerSmallSort(const char* algorithm, Sort sort) {
+    std::string name = std::string("small_sort/") + algorithm + "/" + bench::typeName<T>() + "/" +
+                       std::to_string(N);
+    benchmark::RegisterBenchmark(name.c_str(), [sort](benchmark::State& state) {
+        constexpr size_t kBatches = 4096;
+        const std::vector<T> flat = bench::makeInput<T>(kBatches * N, Distribution::Random);
+        std::vector<std::array<T, N>> input(kBatches);
+        for (size_t b = 0; b < kBatches; ++b) {
+            std::copy(flat.begin() + b * N, flat.begin() + (b + 1) * N, input[b].begin());
+        }
+        std::vector<std::array<T, N>> data(input);
+        for (auto _ : state) {
+            std::copy(input.begin(), input.end(), data.begin());
+            for (auto& batch : data) sort(batch);
+            benchmark::DoNotOptimize(data.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kBatches * N));
+    })->Unit(benchmark::kMicrosecond);
+}
+
+template <typename T, size_t N>
+void registerSmallSorts() {
+    using Array = std::array<T, N>;
+    registerSmallSort<T, N>("std_sort", [](Array& a) { std::sort(a.begin(), a.end()); });
+    registerSmallSort<T, N>("insertionSort", [](Array& a) { dsa::sort::insertionSort(a.begin(), a.end()); });
+    registerSmallSort<T, N>("staticSort", [](Array& a) { dsa::sort::staticSort(a); });
+}
+
+template <typename T>
+void registerSmallSorts() {
+    registerSmallSorts<T, 4>();
+    registerSmallSorts<T, 8>();
+    registerSmallSorts<T, 16>();
+    registerSmallSorts<T, 32>();
+}
+
+const bool registered = [] {
+    registerSorts<int>();
+    registerSorts<double>();
+    registerSorts<std::string>();
+    registerSorts<Record>();
+    registerSelects<int>();
+    registerSelects<double>();
+    registerSelects<std::string>();
+    registerSelects<Record>();
+    registerSmallSorts<int>();
+    registerSmallSorts<double>();
+    return true;
+}();
+
+} // namespace
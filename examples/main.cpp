@@ -6,11 +6,15 @@
  * Compile with: g++ -std=c++17 -I../include main.cpp -o demo
  */
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <iostream>
 #include <vector>
 #include "dsa/LinkedList.hpp"
 #include "dsa/BinarySearchTree.hpp"
 #include "dsa/Sorting.hpp"
+#include "dsa/Selection.hpp"
 
 void printSeparator(const std::string& title) {
     std::cout << "\n" << std::string(50, '=') << "\n";
@@ -100,6 +104,10 @@ void demoBST() {
     for (auto val : bst.levelOrderTraversal()) std::cout << val << " ";
     std::cout << std::endl;
     
+    std::cout << "  Range [25, 65]: ";
+    for (auto val : bst.range(25, 65)) std::cout << val << " ";
+    std::cout << std::endl;
+    
     // Search
     std::cout << "\nContains 40? " << (bst.contains(40) ? "Yes" : "No") << std::endl;
     std::cout << "Contains 55? " << (bst.contains(55) ? "Yes" : "No") << std::endl;
@@ -108,6 +116,16 @@ void demoBST() {
     bst.remove(30);
     std::cout << "\nAfter removing 30: ";
     bst.print();
+    
+    // Balanced variant stays shallow on sorted input
+    dsa::BinarySearchTree<int> plain;
+    dsa::BalancedTree<int> balanced;
+    for (int i = 0; i < 1000; ++i) {
+        plain.insert(i);
+        balanced.insert(i);
+    }
+    std::cout << "\nHeight after 1000 sorted inserts: plain = " << plain.height()
+              << ", balanced = " << balanced.height() << std::endl;
 }
 
 void demoSorting() {
@@ -162,6 +180,42 @@ void demoSorting() {
     // Verify sorted
     std::cout << "\nIs ascending sorted? " 
               << (dsa::sort::isSorted(arr, std::greater<int>()) ? "Yes" : "No") << std::endl;
+    
+    // Sorting network for a size known at compile time
+    std::array<int, 8> fixed = {64, 34, 25, 12, 22, 11, 90, 45};
+    dsa::sort::staticSort(fixed);
+    std::cout << "\nStatic Sort (network): ";
+    for (int x : fixed) std::cout << x << " ";
+    std::cout << std::endl;
+    
+    // Equal keys that differ in bits: the network permutes, never duplicates
+    std::array<double, 8> zeros = {0.0, -0.0, 1.0, 0.0, -0.0, -1.0, 0.0, -0.0};
+    dsa::sort::staticSort(zeros);
+    size_t negative = std::count_if(zeros.begin(), zeros.end(), [](double x) { return x == 0.0 && std::signbit(x); });
+    std::cout << "Static Sort keeps -0.0 and +0.0 (3 + 3): " << negative << " + "
+              << std::count(zeros.begin(), zeros.end(), 0.0) - negative << std::endl;
+}
+
+void demoSelection() {
+    printSeparator("SELECTION DEMO");
+    
+    // 0..9999 shuffled by a fixed multiplier, so every run prints the same
+    std::vector<int> values(10000);
+    for (size_t i = 0; i < values.size(); ++i) values[i] = static_cast<int>((i * 7919) % values.size());
+    
+    auto arr = values;
+    dsa::sort::nthElement(arr, arr.size() / 2);
+    std::cout << "Median (nthElement): " << arr[arr.size() / 2] << std::endl;
+    
+    // Large k: select-then-sort
+    arr = values;
+    dsa::sort::partialSort(arr, 2000);
+    std::cout << "partialSort k=2000: first = " << arr.front() << ", 2000th = " << arr[1999]
+              << ", ordered = " << (std::is_sorted(arr.begin(), arr.begin() + 2000) ? "Yes" : "No") << std::endl;
+    
+    std::cout << "topK<5>: ";
+    for (int x : dsa::sort::topK<5>(values)) std::cout << x << " ";
+    std::cout << std::endl;
 }
 
 int main() {
@@ -174,6 +228,7 @@ int main() {
     demoLinkedList();
     demoBST();
     demoSorting();
+    demoSelection();
     
     printSeparator("DEMO COMPLETE");
     std::cout << "Thank you for using the C++ DSA Library!\n\n";
@@ -0,0 +1,136 @@
+#pragma once
+
+/**
+ * @file ArgSort.hpp
+ * @brief Stable index sorts and structure-of-arrays sorting by a key column
+ * @author Neel Patel
+ * @version 1.0.0
+ *
+ * - argSort: the stable sorting permutation of a range; nothing is moved
+ * - applyPermutation: reorder a column by a permutation, moving each element
+ *   exactly once (plus one temporary per cycle)
+ * - sortByKey: sort a key column and apply the same order to any number of
+ *   co-indexed payload columns
+ *
+ * The comparisons run over compact (key, index) pairs, so large records are
+ * never touched while sorting. Numeric keys under the default order are
+ * sorted with the LSD radix sort.
+ */
+
+#include "RadixSort.hpp"
+
+#include <stdexcept>
+#include <tuple>
+
+namespace dsa {
+namespace sort {
+
+namespace detail {
+    // Keys at most this big are copied next to their index while sorting
+    constexpr size_t kArgSortInlineKeyBytes = 32;
+    
+    template <typename Key, typename Compare>
+    constexpr bool isDefaultOrder = std::is_same_v<Compare, std::less<Key>> ||
+                                    std::is_same_v<Compare, std::less<>>;
+    
+    // Move every column in lockstep along the cycles of perm, where
+    // element i of the result is element perm[i] of the input
+    template <typename... Columns>
+    void permuteColumns(const std::vector<size_t>& perm, Columns... columns) {
+        std::vector<bool> placed(perm.size(), false);
+        for (size_t start = 0; start < perm.size(); ++start) {
+            if (placed[start] || perm[start] == start) continue;
+            auto saved = std::make_tuple(std::move(columns[start])...);
+            size_t dst = start;
+            while (perm[dst] != start) {
+                size_t src = perm[dst];
+                ((columns[dst] = std::move(columns[src])), ...);
+                placed[dst] = true;
+                dst = src;
+            }
+            std::apply([&](auto&... values) { ((columns[dst] = std::move(values)), ...); }, saved);
+            placed[dst] = true;
+        }
+    }
+}
+
+// Arg Sort - O(n log n), O(n) for numeric keys; stable. Returns perm such
+// that first[perm[0]], first[perm[1]], ... is sorted by comp(proj(x), proj(y))
+template <typename RandomIt, typename Proj = detail::Identity,
+          typename Compare = std::less<detail::ProjectedKey<Proj, RandomIt>>>
+std::vector<size_t> argSort(RandomIt first, RandomIt last, Compare comp = Compare(), Proj proj = Proj()) {
+    using Key = detail::ProjectedKey<Proj, RandomIt>;
+    size_t n = static_cast<size_t>(last - first);
+    std::vector<size_t> perm(n);
+    
+    if constexpr (std::is_trivially_copyable_v<Key> && sizeof(Key) <= detail::kArgSortInlineKeyBytes) {
+        using Entry = std::pair<Key, size_t>;
+        std::vector<Entry> entries;
+        entries.reserve(n);
+        for (size_t i = 0; i < n; ++i) entries.emplace_back(proj(first[i]), i);
+        if constexpr (detail::isRadixNumeric<Key> && detail::isDefaultOrder<Key, Compare>) {
+            radixSort(entries.begin(), entries.end(), [](const Entry& e) { return e.first; });
+        } else {
+            mergeSort(entries.begin(), entries.end(), [&comp](const Entry& a, const Entry& b) {
+                return comp(a.first, b.first);
+            });
+        }
+        for (size_t i = 0; i < n; ++i) perm[i] = entries[i].second;
+    } else {
+        for (size_t i = 0; i < n; ++i) perm[i] = i;
+        mergeSort(perm.begin(), perm.end(), [&](size_t a, size_t b) {
+            return comp(proj(first[a]), proj(first[b]));
+        });
+    }
+    return perm;
+}
+
+template <typename T, typename Proj = detail::Identity,
+          typename Compare = std::less<detail::ProjectedKey<Proj, typename std::vector<T>::const_iterator>>>
+std::vector<size_t> argSort(const std::vector<T>& arr, Compare comp = Compare(), Proj proj = Proj()) {
+    return argSort(arr.begin(), arr.end(), comp, proj);
+}
+
+template <typename Range, detail::EnableIfRange<Range> = 0, typename Proj = detail::Identity,
+          typename Compare = std::less<detail::ProjectedKey<Proj, detail::RangeIterator<const Range>>>>
+std::vector<size_t> argSort(const Range& range, Compare comp = Compare(), Proj proj = Proj()) {
+    return argSort(std::begin(range), std::end(range), comp, proj);
+}
+
+// Reorder [first, first + perm.size()) in place so that the new element i
+// is the old element perm[i]
+template <typename RandomIt, std::enable_if_t<!detail::is_range<RandomIt>::value, int> = 0>
+void applyPermutation(const std::vector<size_t>& perm, RandomIt first) {
+    detail::permuteColumns(perm, first);
+}
+
+template <typename Range, detail::EnableIfRange<Range> = 0>
+void applyPermutation(const std::vector<size_t>& perm, Range&& range) {
+    if (static_cast<size_t>(std::end(range) - std::begin(range)) != perm.size()) {
+        throw std::invalid_argument("Permutation and range sizes differ");
+    }
+    detail::permuteColumns(perm, std::begin(range));
+}
+
+// Sort the key column with comp and reorder every payload column the same
+// way; stable. All columns must have the same length as keys.
+template <typename Keys, typename Compare, typename... Columns,
+          std::enable_if_t<detail::is_range<Keys>::value && !detail::is_range<Compare>::value, int> = 0>
+void sortByKey(Keys& keys, Compare comp, Columns&... columns) {
+    auto n = std::end(keys) - std::begin(keys);
+    if (((std::end(columns) - std::begin(columns) != n) || ...)) {
+        throw std::invalid_argument("Key and payload columns differ in length");
+    }
+    std::vector<size_t> perm = argSort(std::begin(keys), std::end(keys), comp);
+    detail::permuteColumns(perm, std::begin(keys), std::begin(columns)...);
+}
+
+template <typename Keys, typename... Columns,
+          std::enable_if_t<detail::is_range<Keys>::value &&
+                           (detail::is_range<Columns>::value && ...), int> = 0>
+void sortByKey(Keys& keys, Columns&... columns) {
+    sortByKey(keys, std::less<detail::RangeValue<Keys>>(), columns...);
+}
+
+} // namespace sort
+} // namespace dsa
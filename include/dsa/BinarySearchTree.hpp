@@ -7,49 +7,284 @@
  * @version 1.0.0
  * 
  * Features:
- * - Balanced BST operations
+ * - Optional self-balancing (AVL) via a policy parameter
  * - Traversals (inorder, preorder, postorder, level-order)
- * - Search, insert, delete operations
+ * - Bidirectional in-order iterators, lower/upper bound and lazy range views
+ * - Optional order-statistic augmentation: rank, select, count_range
+ * - Search, insert, delete operations (iterative, stack-safe on any tree shape)
+ * - emplace, move-aware insert and node handles; remove relinks, never copies keys
+ * - O(n) bulk construction from sorted input (fromSorted, assign_sorted, bulk_insert)
+ * - AVL split/join and join-based union, intersection, difference in
+ *   O(m log(n/m + 1)) work, optionally forked over a ThreadPool
+ *   (include ThreadPool.hpp for the execution-policy overloads)
+ * - freeze(): read-only, cache-friendly StaticSearchTree snapshot
+ *   (include StaticSearchTree.hpp to call it)
+ * - Binary save/load for trivially copyable keys (see Serialization.hpp)
+ * - Optional instrumentation policy: allocation counters, nodes visited per
+ *   lookup, latency hooks (see Instrumentation.hpp)
  * - Height, size, and validation
  */
 
+#include <cstdint>
 #include <iostream>
 #include <queue>
 #include <functional>
 #include <optional>
 #include <vector>
 #include <algorithm>
+#include <type_traits>
+#include <memory>
+#include <iterator>
+#include <utility>
+#include <stdexcept>
+#include <filesystem>
+#include <tuple>
+#include "Instrumentation.hpp"
+#include "NodePool.hpp"
+#include "Serialization.hpp"
 
 namespace dsa {
 
-template <typename T>
+// Only needed where the parallel set operations or freeze() are used
+class ThreadPool;
+class TaskGroup;
+namespace execution { struct parallel_policy; }
+template <typename T> class StaticSearchTree;
+
+// Balancing policies for BinarySearchTree
+namespace balance {
+    // Plain BST: no rebalancing, O(n) worst case on sorted input
+    struct None {};
+    
+    // AVL: subtree heights differ by at most one, O(log n) worst case
+    struct AVL {};
+}
+
+// Node augmentation policies for BinarySearchTree
+namespace augment {
+    // No extra per-node data
+    struct None {};
+    
+    // Each node stores its subtree size, enabling rank/select queries
+    struct SubtreeSize {};
+}
+
+namespace detail {
+    // Per-node bookkeeping required by a balancing policy
+    template <typename Balance>
+    struct BalanceField {};
+    
+    template <>
+    struct BalanceField<balance::AVL> {
+        int height = 0;
+    };
+    
+    // Pool argument of the sequential set operations
+    struct NoPool {};
+    
+    // Per-node bookkeeping required by an augmentation policy
+    template <typename Augment>
+    struct AugmentField {};
+    
+    template <>
+    struct AugmentField<augment::SubtreeSize> {
+        size_t count = 1;
+    };
+}
+
+template <typename T, typename Balance = balance::None,
+          typename Allocator = std::allocator<T>,
+          typename Augment = augment::None,
+          typename Instrument = instrument::None>
 class BinarySearchTree {
 private:
-    struct Node {
+    static constexpr bool kBalanced = std::is_same_v<Balance, balance::AVL>;
+    static constexpr bool kCounted = std::is_same_v<Augment, augment::SubtreeSize>;
+    
+    struct Node : detail::BalanceField<Balance>, detail::AugmentField<Augment> {
         T data;
         Node* left;
         Node* right;
+        Node* parent;
         
         explicit Node(const T& value) 
-            : data(value), left(nullptr), right(nullptr) {}
+            : data(value), left(nullptr), right(nullptr), parent(nullptr) {}
+        
+        explicit Node(T&& value)
+            : data(std::move(value)), left(nullptr), right(nullptr), parent(nullptr) {}
+        
+        template <typename... Args>
+        explicit Node(std::in_place_t, Args&&... args)
+            : data(std::forward<Args>(args)...), left(nullptr), right(nullptr), parent(nullptr) {}
     };
     
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+    
     Node* root_;
     size_t size_;
+    NodeAllocator alloc_;
     
-    // Helper functions
-    Node* insert(Node* node, const T& value) {
-        if (!node) {
-            ++size_;
-            return new Node(value);
+    template <typename... Args>
+    Node* createNode(Args&&... args) {
+        Node* node = NodeTraits::allocate(alloc_, 1);
+        try {
+            NodeTraits::construct(alloc_, node, std::forward<Args>(args)...);
+        } catch (...) {
+            NodeTraits::deallocate(alloc_, node, 1);
+            throw;
         }
-        if (value < node->data)
-            node->left = insert(node->left, value);
-        else if (value > node->data)
-            node->right = insert(node->right, value);
+        Instrument::count(instrument::Counter::Allocations);
         return node;
     }
     
+    void destroyNode(Node* node) {
+        NodeTraits::destroy(alloc_, node);
+        NodeTraits::deallocate(alloc_, node, 1);
+        Instrument::count(instrument::Counter::Deallocations);
+    }
+    
+    // Balancing helpers (no-ops for balance::None)
+    static int nodeHeight(const Node* node) {
+        return node ? node->height : -1;
+    }
+    
+    static void updateHeight(Node* node) {
+        node->height = 1 + std::max(nodeHeight(node->left), nodeHeight(node->right));
+    }
+    
+    // Subtree-size helpers (only used with augment::SubtreeSize)
+    static size_t nodeCount(const Node* node) {
+        return node ? node->count : 0;
+    }
+    
+    static void updateCount(Node* node) {
+        if constexpr (kCounted) {
+            node->count = 1 + nodeCount(node->left) + nodeCount(node->right);
+        }
+    }
+    
+    // Adjust subtree sizes on the path from `node` to the root
+    static void adjustCounts(Node* node, bool grow) {
+        if constexpr (kCounted) {
+            for (; node; node = node->parent) {
+                if (grow) ++node->count;
+                else --node->count;
+            }
+        }
+    }
+    
+    // Point whatever referenced `from` (parent link or root_) at `to`
+    void replaceChild(Node* parent, Node* from, Node* to) {
+        if (!parent) root_ = to;
+        else if (parent->left == from) parent->left = to;
+        else parent->right = to;
+        if (to) to->parent = parent;
+    }
+    
+    Node* rotateLeft(Node* node) {
+        Node* pivot = node->right;
+        node->right = pivot->left;
+        if (pivot->left) pivot->left->parent = node;
+        replaceChild(node->parent, node, pivot);
+        pivot->left = node;
+        node->parent = pivot;
+        updateHeight(node);
+        updateHeight(pivot);
+        updateCount(node);
+        updateCount(pivot);
+        return pivot;
+    }
+    
+    Node* rotateRight(Node* node) {
+        Node* pivot = node->left;
+        node->left = pivot->right;
+        if (pivot->right) pivot->right->parent = node;
+        replaceChild(node->parent, node, pivot);
+        pivot->right = node;
+        node->parent = pivot;
+        updateHeight(node);
+        updateHeight(pivot);
+        updateCount(node);
+        updateCount(pivot);
+        return pivot;
+    }
+    
+    // Restore the AVL invariant at `node`; returns the new subtree root
+    Node* rebalance(Node* node) {
+        updateHeight(node);
+        int factor = nodeHeight(node->left) - nodeHeight(node->right);
+        if (factor > 1) {
+            if (nodeHeight(node->left->left) < nodeHeight(node->left->right))
+                rotateLeft(node->left);
+            return rotateRight(node);
+        }
+        if (factor < -1) {
+            if (nodeHeight(node->right->right) < nodeHeight(node->right->left))
+                rotateRight(node->right);
+            return rotateLeft(node);
+        }
+        return node;
+    }
+    
+    // Walk from `node` towards the root fixing heights, stopping as soon
+    // as a subtree's height is unchanged (ancestors are then unaffected)
+    void retrace(Node* node) {
+        if constexpr (kBalanced) {
+            while (node) {
+                int oldHeight = node->height;
+                node = rebalance(node);
+                if (node->height == oldHeight) break;
+                node = node->parent;
+            }
+        }
+    }
+    
+    // Helper functions (all iterative: call-stack depth never depends on tree height)
+    // Empty link where value belongs (parent set to its owner), or
+    // nullptr if value is already present
+    Node** findLink(const T& value, Node*& parent) {
+        parent = nullptr;
+        Node** link = &root_;
+        while (*link) {
+            parent = *link;
+            if (value < parent->data) link = &parent->left;
+            else if (parent->data < value) link = &parent->right;
+            else return nullptr;
+        }
+        return link;
+    }
+    
+    // Hang a detached node on an empty link and restore the invariants
+    void attach(Node** link, Node* parent, Node* node) {
+        node->left = node->right = nullptr;
+        node->parent = parent;
+        static_cast<detail::BalanceField<Balance>&>(*node) = {};
+        static_cast<detail::AugmentField<Augment>&>(*node) = {};
+        *link = node;
+        ++size_;
+        adjustCounts(parent, true);
+        retrace(parent);
+    }
+    
+    // Looks the key up before allocating, so duplicates cost nothing
+    template <typename V>
+    void insertNode(V&& value) {
+        Node* parent;
+        if (Node** link = findLink(value, parent)) {
+            attach(link, parent, createNode(std::forward<V>(value)));
+        }
+    }
+    
+    // Link an already constructed node; false if its key is present
+    bool linkNode(Node* node) {
+        Node* parent;
+        Node** link = findLink(node->data, parent);
+        if (!link) return false;
+        attach(link, parent, node);
+        return true;
+    }
+    
     Node* findMin(Node* node) const {
         while (node && node->left) node = node->left;
         return node;
@@ -60,110 +295,1012 @@ private:
         return node;
     }
     
-    Node* remove(Node* node, const T& value) {
-        if (!node) return nullptr;
-        
-        if (value < node->data) {
-            node->left = remove(node->left, value);
-        } else if (value > node->data) {
-            node->right = remove(node->right, value);
-        } else {
-            // Node found
-            if (!node->left) {
-                Node* temp = node->right;
-                delete node;
-                --size_;
-                return temp;
-            } else if (!node->right) {
-                Node* temp = node->left;
-                delete node;
-                --size_;
-                return temp;
+    Node* findNode(const T& value) const {
+        Instrument::count(instrument::Counter::Lookups);
+        uint64_t visited = 0;
+        Node* node = root_;
+        while (node) {
+            ++visited;
+            if (value < node->data) node = node->left;
+            else if (node->data < value) node = node->right;
+            else break;
+        }
+        Instrument::count(instrument::Counter::NodesVisited, visited);
+        return node;
+    }
+    
+    // Detach node from the tree and rebalance; the node itself is untouched
+    // apart from its links, so it can be destroyed or handed out
+    Node* unlinkNode(Node* node) {
+        Node* fixFrom; // lowest node whose subtree lost an element
+        if (node->left && node->right) {
+            // Two children: relink the inorder successor into the node's
+            // place instead of copying its key over
+            Node* succ = findMin(node->right);
+            if (succ == node->right) {
+                fixFrom = succ;
+            } else {
+                fixFrom = succ->parent;
+                fixFrom->left = succ->right;
+                if (succ->right) succ->right->parent = fixFrom;
+                succ->right = node->right;
+                succ->right->parent = succ;
             }
-            // Two children: get inorder successor
-            Node* temp = findMin(node->right);
-            node->data = temp->data;
-            node->right = remove(node->right, temp->data);
+            succ->left = node->left;
+            succ->left->parent = succ;
+            static_cast<detail::BalanceField<Balance>&>(*succ) = *node;
+            static_cast<detail::AugmentField<Augment>&>(*succ) = *node;
+            replaceChild(node->parent, node, succ);
+        } else {
+            // At most one child: splice it into the node's place
+            Node* child = node->left ? node->left : node->right;
+            fixFrom = node->parent;
+            replaceChild(fixFrom, node, child);
         }
+        node->left = node->right = node->parent = nullptr;
+        --size_;
+        adjustCounts(fixFrom, false);
+        retrace(fixFrom);
         return node;
     }
     
-    bool search(Node* node, const T& value) const {
-        if (!node) return false;
-        if (value == node->data) return true;
-        if (value < node->data) return search(node->left, value);
-        return search(node->right, value);
+    void removeNode(Node* node) {
+        destroyNode(unlinkNode(node));
+    }
+    
+    bool search(const T& value) const {
+        return findNode(value) != nullptr;
     }
     
     int height(Node* node) const {
-        if (!node) return -1;
-        return 1 + std::max(height(node->left), height(node->right));
+        int result = -1;
+        traverse<Order::Pre>(node, [&result](const Node*, int depth) {
+            result = std::max(result, depth);
+        });
+        return result;
     }
     
+    // Destroy a subtree in O(1) extra space by rotating left children up
+    // into a right-leaning spine and freeing it from the top
     void clear(Node* node) {
-        if (node) {
-            clear(node->left);
-            clear(node->right);
-            delete node;
+        while (node) {
+            if (Node* left = node->left) {
+                node->left = left->right;
+                left->right = node;
+                node = left;
+            } else {
+                Node* right = node->right;
+                destroyNode(node);
+                node = right;
+            }
+        }
+    }
+    
+    bool isValidBST(Node* node) const {
+        Node* prev = nullptr;
+        for (Node* curr = findMin(node); curr; curr = successor(curr)) {
+            if (prev && !(prev->data < curr->data)) return false;
+            prev = curr;
+        }
+        return true;
+    }
+    
+    // Bulk construction helpers
+    
+    // Link nodes[0..n) (in key order) into a perfectly balanced subtree under
+    // `parent`; recursion depth is log2(n). Returns the subtree root.
+    static Node* linkBalanced(Node* const* nodes, size_t n, Node* parent) {
+        if (n == 0) return nullptr;
+        size_t mid = n / 2;
+        Node* node = nodes[mid];
+        node->parent = parent;
+        node->left = linkBalanced(nodes, mid, node);
+        node->right = linkBalanced(nodes + mid + 1, n - mid - 1, node);
+        if constexpr (kBalanced) updateHeight(node);
+        updateCount(node);
+        return node;
+    }
+    
+    // Allocate a node per value, back to back in the pool where possible;
+    // on failure every node made so far is freed
+    template <typename It>
+    std::vector<Node*> createNodes(It first, It last, size_t n) {
+        std::vector<Node*> nodes;
+        nodes.reserve(n);
+        detail::tryReserve<Node>(alloc_, n);
+        try {
+            for (; first != last; ++first) nodes.push_back(createNode(std::move(*first)));
+        } catch (...) {
+            for (Node* node : nodes) destroyNode(node);
+            throw;
+        }
+        return nodes;
+    }
+    
+    // Replace the contents with a balanced tree of strictly increasing values.
+    // Clears first: clear() may hand the whole pool back at once.
+    void buildFrom(std::vector<T>& values) {
+        clear();
+        std::vector<Node*> nodes = createNodes(values.begin(), values.end(), values.size());
+        root_ = linkBalanced(nodes.data(), nodes.size(), nullptr);
+        size_ = nodes.size();
+    }
+    
+    // Split/join primitives (balance::AVL only). They work on detached
+    // subtrees whose root has no parent and never touch root_; recursion
+    // depth is O(log n).
+    
+    static void setChildren(Node* node, Node* left, Node* right) {
+        node->left = left;
+        node->right = right;
+        if (left) left->parent = node;
+        if (right) right->parent = node;
+        updateHeight(node);
+        updateCount(node);
+    }
+    
+    static Node* detachedRotateLeft(Node* node) {
+        Node* pivot = node->right;
+        Node* parent = node->parent;
+        setChildren(node, node->left, pivot->left);
+        setChildren(pivot, node, pivot->right);
+        pivot->parent = parent;
+        return pivot;
+    }
+    
+    static Node* detachedRotateRight(Node* node) {
+        Node* pivot = node->left;
+        Node* parent = node->parent;
+        setChildren(node, pivot->right, node->right);
+        setChildren(pivot, pivot->left, node);
+        pivot->parent = parent;
+        return pivot;
+    }
+    
+    // rebalance() for a node whose height and count are already current
+    static Node* detachedRebalance(Node* node) {
+        int factor = nodeHeight(node->left) - nodeHeight(node->right);
+        if (factor > 1) {
+            if (nodeHeight(node->left->left) < nodeHeight(node->left->right))
+                node->left = detachedRotateLeft(node->left);
+            return detachedRotateRight(node);
+        }
+        if (factor < -1) {
+            if (nodeHeight(node->right->right) < nodeHeight(node->right->left))
+                node->right = detachedRotateRight(node->right);
+            return detachedRotateLeft(node);
+        }
+        return node;
+    }
+    
+    // Left is taller: hang (sub, key, right) off its right spine
+    static Node* joinRight(Node* left, Node* key, Node* right) {
+        Node* sub;
+        if (nodeHeight(left->right) <= nodeHeight(right) + 1) {
+            setChildren(key, left->right, right);
+            sub = key;
+        } else {
+            sub = joinRight(left->right, key, right);
+        }
+        setChildren(left, left->left, sub);
+        return detachedRebalance(left);
+    }
+    
+    static Node* joinLeft(Node* left, Node* key, Node* right) {
+        Node* sub;
+        if (nodeHeight(right->left) <= nodeHeight(left) + 1) {
+            setChildren(key, left, right->left);
+            sub = key;
+        } else {
+            sub = joinLeft(left, key, right->left);
+        }
+        setChildren(right, sub, right->right);
+        return detachedRebalance(right);
+    }
+    
+    // AVL tree of left, key, right where left < key < right; O(|h(left) - h(right)| + 1)
+    static Node* joinNodes(Node* left, Node* key, Node* right) {
+        Node* root;
+        if (nodeHeight(left) > nodeHeight(right) + 1) root = joinRight(left, key, right);
+        else if (nodeHeight(right) > nodeHeight(left) + 1) root = joinLeft(left, key, right);
+        else { setChildren(key, left, right); root = key; }
+        root->parent = nullptr;
+        return root;
+    }
+    
+    // Detach the children of node (its links are left dangling)
+    static std::pair<Node*, Node*> expose(Node* node) {
+        Node* left = node->left;
+        Node* right = node->right;
+        if (left) left->parent = nullptr;
+        if (right) right->parent = nullptr;
+        return {left, right};
+    }
+    
+    // Split a subtree into keys < value and keys > value; returns the node
+    // equal to value, detached, or nullptr. O(log n).
+    static Node* splitNodes(Node* node, const T& value, Node*& left, Node*& right) {
+        if (!node) {
+            left = right = nullptr;
+            return nullptr;
+        }
+        auto [l, r] = expose(node);
+        Node* match;
+        if (value < node->data) {
+            match = splitNodes(l, value, left, right);
+            right = joinNodes(right, node, r);
+        } else if (node->data < value) {
+            match = splitNodes(r, value, left, right);
+            left = joinNodes(l, node, left);
+        } else {
+            left = l;
+            right = r;
+            node->left = node->right = node->parent = nullptr;
+            match = node;
+        }
+        return match;
+    }
+    
+    // Take the maximum node out of a non-empty subtree; rest gets the others
+    static Node* splitLast(Node* node, Node*& rest) {
+        auto [l, r] = expose(node);
+        if (!r) {
+            rest = l;
+            return node;
+        }
+        Node* subRest;
+        Node* last = splitLast(r, subRest);
+        rest = joinNodes(l, node, subRest);
+        return last;
+    }
+    
+    // Concatenate subtrees with left < right; O(log n)
+    static Node* join2(Node* left, Node* right) {
+        if (!left) return right;
+        Node* rest;
+        Node* last = splitLast(left, rest);
+        return joinNodes(rest, last, right);
+    }
+    
+    // Nodes a set operation leaves out, linked through `right`. They are
+    // freed afterwards on the calling thread: allocators such as
+    // PoolAllocator are not thread-safe, and forked tasks never allocate.
+    struct Chain {
+        Node* head = nullptr;
+        Node* tail = nullptr;
+        size_t count = 0;
+        
+        void push(Node* node) {
+            node->right = head;
+            head = node;
+            if (!tail) tail = node;
+            ++count;
+        }
+        
+        void append(Chain& other) {
+            if (!other.head) return;
+            other.tail->right = head;
+            head = other.head;
+            if (!tail) tail = other.tail;
+            count += other.count;
+        }
+    };
+    
+    static void dropSubtree(Node* node, Chain& dropped) {
+        if (!node) return;
+        dropSubtree(node->left, dropped);
+        dropSubtree(node->right, dropped);
+        dropped.push(node);
+    }
+    
+    // Run left and right, forked on the pool when the subproblem is tall
+    // enough to be worth a task. Group is a template parameter so that
+    // TaskGroup need only be complete where a parallel overload is used.
+    template <typename Pool, typename Left, typename Right, typename Group = TaskGroup>
+    static std::pair<Node*, Node*> forkJoin(Pool* pool, bool fork, Chain& dropped,
+                                            Left left, Right right) {
+        if constexpr (!std::is_same_v<Pool, detail::NoPool>) {
+            if (fork) {
+                Chain leftDropped;
+                Node* l = nullptr;
+                Group group(*pool);
+                group.run([&] { l = left(leftDropped); });
+                Node* r = right(dropped);
+                group.wait();
+                dropped.append(leftDropped);
+                return {l, r};
+            }
+        }
+        Node* l = left(dropped);
+        return {l, right(dropped)};
+    }
+    
+    // Join-based set algebra over two subtrees; O(m log(n/m + 1)) work and
+    // O(log n log m) span for sizes m <= n. Every node of either input ends
+    // up in the result or in `dropped`.
+    template <typename Pool>
+    static Node* unionNodes(Node* a, Node* b, Chain& dropped, Pool* pool, int forkHeight) {
+        if (!a) return b;
+        if (!b) return a;
+        Node *bl, *br;
+        if (Node* dup = splitNodes(b, a->data, bl, br)) dropped.push(dup);
+        // Lambdas cannot capture structured bindings in C++17
+        Node *al, *ar;
+        std::tie(al, ar) = expose(a);
+        auto [l, r] = forkJoin(pool, nodeHeight(a) >= forkHeight, dropped,
+            [&](Chain& c) { return unionNodes(al, bl, c, pool, forkHeight); },
+            [&](Chain& c) { return unionNodes(ar, br, c, pool, forkHeight); });
+        return joinNodes(l, a, r);
+    }
+    
+    template <typename Pool>
+    static Node* intersectNodes(Node* a, Node* b, Chain& dropped, Pool* pool, int forkHeight) {
+        if (!a || !b) {
+            dropSubtree(a, dropped);
+            dropSubtree(b, dropped);
+            return nullptr;
+        }
+        Node *bl, *br;
+        Node* dup = splitNodes(b, a->data, bl, br);
+        Node *al, *ar;
+        std::tie(al, ar) = expose(a);
+        auto [l, r] = forkJoin(pool, nodeHeight(a) >= forkHeight, dropped,
+            [&](Chain& c) { return intersectNodes(al, bl, c, pool, forkHeight); },
+            [&](Chain& c) { return intersectNodes(ar, br, c, pool, forkHeight); });
+        if (dup) {
+            dropped.push(dup);
+            return joinNodes(l, a, r);
+        }
+        dropped.push(a);
+        return join2(l, r);
+    }
+    
+    // Keys of a that are not in b
+    template <typename Pool>
+    static Node* differenceNodes(Node* a, Node* b, Chain& dropped, Pool* pool, int forkHeight) {
+        if (!a || !b) {
+            dropSubtree(b, dropped);
+            return a;
+        }
+        Node *al, *ar;
+        if (Node* dup = splitNodes(a, b->data, al, ar)) dropped.push(dup);
+        Node *bl, *br;
+        std::tie(bl, br) = expose(b);
+        dropped.push(b);
+        auto [l, r] = forkJoin(pool, nodeHeight(b) >= forkHeight, dropped,
+            [&](Chain& c) { return differenceNodes(al, bl, c, pool, forkHeight); },
+            [&](Chain& c) { return differenceNodes(ar, br, c, pool, forkHeight); });
+        return join2(l, r);
+    }
+    
+    template <typename Pool>
+    using SetOperation = Node* (*)(Node*, Node*, Chain&, Pool*, int);
+    
+    // Combine other into this tree, consuming it. Its nodes are relinked
+    // when the allocators are equal and copied into this one's otherwise.
+    template <typename Pool>
+    void combine(BinarySearchTree&& other, SetOperation<Pool> op, Pool* pool, int forkHeight) {
+        static_assert(kBalanced, "set operations require balance::AVL");
+        if (&other == this) {
+            BinarySearchTree copy = fromSorted(begin(), end(), alloc_);
+            combine(std::move(copy), op, pool, forkHeight);
+            return;
+        }
+        if (!(alloc_ == other.alloc_)) {
+            BinarySearchTree copy = fromSorted(other.begin(), other.end(), alloc_);
+            other.clear();
+            combine(std::move(copy), op, pool, forkHeight);
+            return;
+        }
+        size_t total = size_ + other.size_;
+        Node* theirs = std::exchange(other.root_, nullptr);
+        other.size_ = 0;
+        Chain dropped;
+        root_ = op(root_, theirs, dropped, pool, forkHeight);
+        if (root_) root_->parent = nullptr;
+        size_ = total - dropped.count;
+        for (Node* node = dropped.head; node;) {
+            Node* next = node->right;
+            destroyNode(node);
+            node = next;
+        }
+    }
+    
+    // combine() forked over the policy's pool from subtrees of about
+    // log2(grain) height up; a template so that the policy is complete
+    template <typename Policy>
+    void combineOn(const Policy& policy, BinarySearchTree&& other, SetOperation<ThreadPool> op) {
+        int forkHeight = 0;
+        for (size_t n = policy.grainSize; n > 1; n >>= 1) ++forkHeight;
+        combine(std::move(other), op, &policy.pool(), forkHeight);
+    }
+    
+    // Node-for-node copy of a subtree (same shape, heights and counts),
+    // walking source and copy in step over parent links; O(n), no recursion
+    Node* cloneTree(const Node* source, size_t n) {
+        if (!source) return nullptr;
+        detail::tryReserve<Node>(alloc_, n);
+        auto cloneNode = [this](const Node* from, Node* parent) {
+            Node* node = createNode(from->data);
+            static_cast<detail::BalanceField<Balance>&>(*node) = *from;
+            static_cast<detail::AugmentField<Augment>&>(*node) = *from;
+            node->parent = parent;
+            return node;
+        };
+        Node* root = cloneNode(source, nullptr);
+        try {
+            const Node* from = source;
+            Node* to = root;
+            while (true) {
+                if (from->left && !to->left) {
+                    to->left = cloneNode(from->left, to);
+                    from = from->left;
+                    to = to->left;
+                } else if (from->right && !to->right) {
+                    to->right = cloneNode(from->right, to);
+                    from = from->right;
+                    to = to->right;
+                } else if (from == source) {
+                    break;
+                } else {
+                    from = from->parent;
+                    to = to->parent;
+                }
+            }
+        } catch (...) {
+            clear(root);
+            throw;
         }
+        return root;
     }
     
-    bool isValidBST(Node* node, const T* minVal, const T* maxVal) const {
-        if (!node) return true;
-        if ((minVal && node->data <= *minVal) || 
-            (maxVal && node->data >= *maxVal))
-            return false;
-        return isValidBST(node->left, minVal, &node->data) &&
-               isValidBST(node->right, &node->data, maxVal);
+    // Balanced copy with an allocator chosen as for a container copy
+    BinarySearchTree copyKeys() const {
+        return fromSorted(begin(), end(), NodeTraits::select_on_container_copy_construction(alloc_));
+    }
+    
+    // Size of subtree a, where a and b hold `total` keys between them:
+    // O(1) with subtree counts, else both are walked in step, O(min(k, total - k))
+    static size_t sizeOfFirst(Node* a, Node* b, size_t total) {
+        if constexpr (kCounted) {
+            return nodeCount(a);
+        } else {
+            while (a && a->left) a = a->left;
+            while (b && b->left) b = b->left;
+            for (size_t steps = 0;; ++steps) {
+                if (!a) return steps;
+                if (!b) return total - steps;
+                a = successor(a);
+                b = successor(b);
+            }
+        }
     }
     
     // Traversal helpers
-    void inorder(Node* node, std::vector<T>& result) const {
-        if (node) {
-            inorder(node->left, result);
-            result.push_back(node->data);
-            inorder(node->right, result);
+    static Node* successor(Node* node) {
+        if (node->right) {
+            node = node->right;
+            while (node->left) node = node->left;
+            return node;
         }
+        while (node->parent && node == node->parent->right) node = node->parent;
+        return node->parent;
     }
     
-    void preorder(Node* node, std::vector<T>& result) const {
-        if (node) {
-            result.push_back(node->data);
-            preorder(node->left, result);
-            preorder(node->right, result);
+    static Node* predecessor(Node* node) {
+        if (node->left) {
+            node = node->left;
+            while (node->right) node = node->right;
+            return node;
         }
+        while (node->parent && node == node->parent->left) node = node->parent;
+        return node->parent;
     }
     
-    void postorder(Node* node, std::vector<T>& result) const {
-        if (node) {
-            postorder(node->left, result);
-            postorder(node->right, result);
-            result.push_back(node->data);
+    // First node with data >= value (lower) or data > value (upper)
+    Node* lowerBoundNode(const T& value) const {
+        Node* result = nullptr;
+        for (Node* node = root_; node;) {
+            if (node->data < value) node = node->right;
+            else { result = node; node = node->left; }
+        }
+        return result;
+    }
+    
+    Node* upperBoundNode(const T& value) const {
+        Node* result = nullptr;
+        for (Node* node = root_; node;) {
+            if (value < node->data) { result = node; node = node->left; }
+            else node = node->right;
+        }
+        return result;
+    }
+    
+    enum class Order { Pre, In, Post };
+    
+    // Stackless depth-first walk over parent links; visit(node, depth)
+    // fires when `node` is reached in the requested order
+    template <Order order, typename Visit>
+    void traverse(Node* start, Visit visit) const {
+        if (!start) return;
+        Node* prev = start->parent;
+        Node* curr = start;
+        int depth = 0;
+        while (true) {
+            if (prev == curr->parent) {
+                // Arrived from above
+                if constexpr (order == Order::Pre) visit(curr, depth);
+                prev = curr;
+                if (curr->left) { curr = curr->left; ++depth; continue; }
+                if constexpr (order == Order::In) visit(curr, depth);
+                if (curr->right) { curr = curr->right; ++depth; continue; }
+            } else if (prev == curr->left) {
+                // Finished the left subtree
+                if constexpr (order == Order::In) visit(curr, depth);
+                prev = curr;
+                if (curr->right) { curr = curr->right; ++depth; continue; }
+            } else {
+                // Finished the right subtree
+                prev = curr;
+            }
+            if constexpr (order == Order::Post) visit(curr, depth);
+            if (curr == start) break;
+            curr = curr->parent;
+            --depth;
+        }
+    }
+    
+    void collect(Node* node, std::vector<T>& result, Order order) const {
+        result.reserve(size_);
+        auto push = [&result](const Node* n, int) { result.push_back(n->data); };
+        switch (order) {
+            case Order::Pre:  traverse<Order::Pre>(node, push); break;
+            case Order::In:   traverse<Order::In>(node, push); break;
+            case Order::Post: traverse<Order::Post>(node, push); break;
         }
     }
 
 public:
-    BinarySearchTree() : root_(nullptr), size_(0) {}
+    using allocator_type = Allocator;
+    using node_type = NodeHandle<T, Node, NodeAllocator>;
+    
+    BinarySearchTree() : BinarySearchTree(Allocator()) {}
     
-    BinarySearchTree(std::initializer_list<T> init) : BinarySearchTree() {
-        for (const auto& item : init) insert(item);
+    explicit BinarySearchTree(const Allocator& alloc)
+        : root_(nullptr), size_(0), alloc_(alloc) {}
+    
+    // A plain BST keeps the shape given by the insertion order; a balanced
+    // tree is bulk-built since its shape never depends on that order
+    BinarySearchTree(std::initializer_list<T> init, const Allocator& alloc = Allocator())
+        : BinarySearchTree(alloc) {
+        if constexpr (kBalanced) bulk_insert(init.begin(), init.end());
+        else for (const auto& item : init) insert(item);
+    }
+    
+    // Deep copy preserving the shape; O(n)
+    BinarySearchTree(const BinarySearchTree& other)
+        : BinarySearchTree(NodeTraits::select_on_container_copy_construction(other.alloc_)) {
+        root_ = cloneTree(other.root_, other.size_);
+        size_ = other.size_;
+    }
+    
+    BinarySearchTree(BinarySearchTree&& other) noexcept
+        : root_(std::exchange(other.root_, nullptr)), size_(std::exchange(other.size_, 0)),
+          alloc_(std::move(other.alloc_)) {}
+    
+    BinarySearchTree& operator=(const BinarySearchTree& other) {
+        if (this != &other) {
+            clear();
+            if constexpr (NodeTraits::propagate_on_container_copy_assignment::value) {
+                alloc_ = other.alloc_;
+            }
+            root_ = cloneTree(other.root_, other.size_);
+            size_ = other.size_;
+        }
+        return *this;
+    }
+    
+    // Nodes are stolen unless the allocators differ and do not propagate;
+    // then the keys are copied into nodes from this tree's allocator
+    BinarySearchTree& operator=(BinarySearchTree&& other) {
+        if (this == &other) return *this;
+        constexpr bool propagate = NodeTraits::propagate_on_container_move_assignment::value;
+        if (!propagate && !(alloc_ == other.alloc_)) {
+            std::vector<T> keys = other.inorderTraversal();
+            buildFrom(keys);
+            other.clear();
+            return *this;
+        }
+        clear();
+        if constexpr (propagate) alloc_ = std::move(other.alloc_);
+        root_ = std::exchange(other.root_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        return *this;
     }
     
     ~BinarySearchTree() { clear(); }
     
+    // Perfectly balanced tree from ascending input in O(n); equal neighbours
+    // are kept once. Throws std::invalid_argument if the input is not sorted.
+    template <typename InputIt>
+    static BinarySearchTree fromSorted(InputIt first, InputIt last, const Allocator& alloc = Allocator()) {
+        BinarySearchTree tree(alloc);
+        tree.assign_sorted(first, last);
+        return tree;
+    }
+    
+    // In-order bidirectional iterator; elements are read-only since
+    // modifying a key in place would break the ordering invariant
+    class Iterator {
+    private:
+        Node* current_;
+        const BinarySearchTree* tree_;
+        friend class BinarySearchTree;
+        
+        Iterator(Node* node, const BinarySearchTree* tree) : current_(node), tree_(tree) {}
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+        
+        Iterator() : current_(nullptr), tree_(nullptr) {}
+        
+        reference operator*() const { return current_->data; }
+        pointer operator->() const { return &(current_->data); }
+        
+        Iterator& operator++() {
+            current_ = successor(current_);
+            return *this;
+        }
+        
+        Iterator operator++(int) {
+            Iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+        
+        // Decrementing end() yields the maximum element
+        Iterator& operator--() {
+            current_ = current_ ? predecessor(current_) : tree_->findMax(tree_->root_);
+            return *this;
+        }
+        
+        Iterator operator--(int) {
+            Iterator tmp = *this;
+            --(*this);
+            return tmp;
+        }
+        
+        friend bool operator==(const Iterator& a, const Iterator& b) {
+            return a.current_ == b.current_;
+        }
+        
+        friend bool operator!=(const Iterator& a, const Iterator& b) {
+            return a.current_ != b.current_;
+        }
+    };
+    
+    using iterator = Iterator;
+    using const_iterator = Iterator;
+    
+    // Lazy [first, last) view over a slice of the tree; no allocation
+    class Range {
+    private:
+        Iterator first_, last_;
+    public:
+        Range(Iterator first, Iterator last) : first_(first), last_(last) {}
+        Iterator begin() const { return first_; }
+        Iterator end() const { return last_; }
+        [[nodiscard]] bool empty() const { return first_ == last_; }
+    };
+    
+    [[nodiscard]] allocator_type get_allocator() const { return allocator_type(alloc_); }
+    
     // Capacity
     [[nodiscard]] bool empty() const { return size_ == 0; }
     [[nodiscard]] size_t size() const { return size_; }
-    [[nodiscard]] int height() const { return height(root_); }
+    [[nodiscard]] int height() const {
+        if constexpr (kBalanced) return nodeHeight(root_);
+        else return height(root_);
+    }
     
     // Modifiers
-    void insert(const T& value) { root_ = insert(root_, value); }
-    void remove(const T& value) { root_ = remove(root_, value); }
-    void clear() { clear(root_); root_ = nullptr; size_ = 0; }
+    void insert(const T& value) {
+        instrument::Timer<Instrument> timer(instrument::Operation::Insert);
+        insertNode(value);
+    }
+    
+    void insert(T&& value) {
+        instrument::Timer<Instrument> timer(instrument::Operation::Insert);
+        insertNode(std::move(value));
+    }
+    
+    // Construct the key in place; true if it was not already present
+    // (a duplicate is constructed, compared and destroyed)
+    template <typename... Args>
+    bool emplace(Args&&... args) {
+        instrument::Timer<Instrument> timer(instrument::Operation::Insert);
+        Node* node = createNode(std::in_place, std::forward<Args>(args)...);
+        if (linkNode(node)) return true;
+        destroyNode(node);
+        return false;
+    }
+    
+    void remove(const T& value) {
+        instrument::Timer<Instrument> timer(instrument::Operation::Erase);
+        if (Node* node = findNode(value)) removeNode(node);
+    }
+    
+    // Unlink a key and hand its node to the caller; empty if absent
+    node_type extract(const T& value) {
+        Node* node = findNode(value);
+        if (!node) return node_type();
+        return detail::NodeHandleAccess::make<node_type>(unlinkNode(node), alloc_);
+    }
+    
+    node_type extract(Iterator pos) {
+        return detail::NodeHandleAccess::make<node_type>(unlinkNode(pos.current_), alloc_);
+    }
+    
+    // Link an extracted node without reallocating. True if it was inserted;
+    // on a duplicate key the handle keeps the node. The node must come from
+    // a tree with an equal allocator (std::invalid_argument otherwise).
+    bool insert(node_type&& handle) {
+        if (handle.empty()) return false;
+        if (!(detail::NodeHandleAccess::allocator(handle) == alloc_)) {
+            throw std::invalid_argument("Node handle uses a different allocator");
+        }
+        Node* parent;
+        Node** link = findLink(handle.value(), parent);
+        if (!link) return false;
+        attach(link, parent, detail::NodeHandleAccess::release(handle));
+        return true;
+    }
+    // Hands a pool back whole when nothing else uses it
+    void clear() {
+        if (detail::tryBulkRelease<Node>(alloc_)) Instrument::count(instrument::Counter::Deallocations, size_);
+        else clear(root_);
+        root_ = nullptr;
+        size_ = 0;
+    }
+    
+    // Replace the contents with ascending input in O(n); see fromSorted
+    template <typename InputIt>
+    void assign_sorted(InputIt first, InputIt last) {
+        std::vector<T> values;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                                        typename std::iterator_traits<InputIt>::iterator_category>) {
+            values.reserve(static_cast<size_t>(std::distance(first, last)));
+        }
+        for (; first != last; ++first) {
+            if (!values.empty()) {
+                if (*first < values.back()) throw std::invalid_argument("assign_sorted: input is not sorted");
+                if (!(values.back() < *first)) continue;
+            }
+            values.push_back(*first);
+        }
+        buildFrom(values);
+    }
+    
+    // Insert a batch in O(n + m log m): sort it, merge it with the current
+    // keys and rebuild balanced. Batches small next to the tree
+    // (m log n < n) are inserted one by one instead.
+    template <typename InputIt>
+    void bulk_insert(InputIt first, InputIt last) {
+        std::vector<T> batch(first, last);
+        std::sort(batch.begin(), batch.end());
+        batch.erase(std::unique(batch.begin(), batch.end(),
+                                [](const T& a, const T& b) { return !(a < b); }),
+                    batch.end());
+        
+        size_t logN = 0;
+        for (size_t n = size_; n > 1; n >>= 1) ++logN;
+        if (batch.size() * logN < size_) {
+            for (const T& value : batch) insertNode(value);
+            return;
+        }
+        
+        // Keep only the keys not already present
+        std::vector<T> fresh;
+        fresh.reserve(batch.size());
+        Node* node = findMin(root_);
+        for (T& value : batch) {
+            while (node && node->data < value) node = successor(node);
+            if (!node || value < node->data) fresh.push_back(std::move(value));
+        }
+        if (fresh.empty()) return;
+        
+        // Relink the existing nodes and the new ones in one sorted sequence
+        std::vector<Node*> merged;
+        merged.reserve(size_ + fresh.size());
+        std::vector<Node*> added = createNodes(fresh.begin(), fresh.end(), fresh.size());
+        auto next = added.begin();
+        for (node = findMin(root_); node; node = successor(node)) {
+            while (next != added.end() && (*next)->data < node->data) merged.push_back(*next++);
+            merged.push_back(node);
+        }
+        merged.insert(merged.end(), next, added.end());
+        root_ = linkBalanced(merged.data(), merged.size(), nullptr);
+        size_ = merged.size();
+    }
+    
+    // Split and join (require balance::AVL)
+    
+    // Move every key >= key into the returned tree. O(log n), plus
+    // O(min(k, n - k)) to recount the halves without augment::SubtreeSize.
+    BinarySearchTree split(const T& key) {
+        static_assert(kBalanced, "split() requires balance::AVL");
+        Node *left, *right;
+        if (Node* match = splitNodes(root_, key, left, right)) right = joinNodes(nullptr, match, right);
+        size_t upperSize = sizeOfFirst(right, left, size_);
+        BinarySearchTree upper(alloc_);
+        upper.root_ = right;
+        upper.size_ = upperSize;
+        root_ = left;
+        size_ -= upperSize;
+        return upper;
+    }
+    
+    // Concatenate two trees, every key of left below every key of right, in
+    // O(log n). Throws std::invalid_argument if the key ranges overlap or
+    // the allocators differ.
+    static BinarySearchTree join(BinarySearchTree&& left, BinarySearchTree&& right) {
+        static_assert(kBalanced, "join() requires balance::AVL");
+        if (right.empty()) return std::move(left);
+        if (left.empty()) return std::move(right);
+        if (!(left.alloc_ == right.alloc_)) throw std::invalid_argument("Trees use different allocators");
+        if (!(left.findMax(left.root_)->data < right.findMin(right.root_)->data)) {
+            throw std::invalid_argument("join: key ranges overlap");
+        }
+        BinarySearchTree result(std::move(left));
+        result.root_ = join2(result.root_, std::exchange(right.root_, nullptr));
+        result.size_ += std::exchange(right.size_, 0);
+        return result;
+    }
+    
+    // Set algebra (require balance::AVL). Join-based, so O(m log(n/m + 1))
+    // work for sizes m <= n instead of O(n + m) for merging sorted runs.
+    // An rvalue argument is consumed and its nodes relinked into this tree;
+    // an lvalue is copied first. The parallel overloads fork recursive calls
+    // on subtrees above the policy's grain size.
+    void union_with(BinarySearchTree&& other) { combine<detail::NoPool>(std::move(other), &unionNodes, nullptr, 0); }
+    void union_with(const BinarySearchTree& other) { union_with(fromSorted(other.begin(), other.end(), alloc_)); }
+    
+    void intersect_with(BinarySearchTree&& other) { combine<detail::NoPool>(std::move(other), &intersectNodes, nullptr, 0); }
+    void intersect_with(const BinarySearchTree& other) { intersect_with(fromSorted(other.begin(), other.end(), alloc_)); }
+    
+    // Remove every key that other contains
+    void difference_with(BinarySearchTree&& other) { combine<detail::NoPool>(std::move(other), &differenceNodes, nullptr, 0); }
+    void difference_with(const BinarySearchTree& other) { difference_with(fromSorted(other.begin(), other.end(), alloc_)); }
+    
+    void union_with(const execution::parallel_policy& policy, BinarySearchTree&& other) {
+        combineOn(policy, std::move(other), &unionNodes<ThreadPool>);
+    }
+    
+    void union_with(const execution::parallel_policy& policy, const BinarySearchTree& other) {
+        union_with(policy, fromSorted(other.begin(), other.end(), alloc_));
+    }
+    
+    void intersect_with(const execution::parallel_policy& policy, BinarySearchTree&& other) {
+        combineOn(policy, std::move(other), &intersectNodes<ThreadPool>);
+    }
+    
+    void intersect_with(const execution::parallel_policy& policy, const BinarySearchTree& other) {
+        intersect_with(policy, fromSorted(other.begin(), other.end(), alloc_));
+    }
+    
+    void difference_with(const execution::parallel_policy& policy, BinarySearchTree&& other) {
+        combineOn(policy, std::move(other), &differenceNodes<ThreadPool>);
+    }
+    
+    void difference_with(const execution::parallel_policy& policy, const BinarySearchTree& other) {
+        difference_with(policy, fromSorted(other.begin(), other.end(), alloc_));
+    }
+    
+    // Results as new trees, leaving both inputs untouched (copying them costs O(n + m))
+    static BinarySearchTree set_union(const BinarySearchTree& a, const BinarySearchTree& b) {
+        BinarySearchTree result = a.copyKeys();
+        result.union_with(b);
+        return result;
+    }
+    
+    static BinarySearchTree set_intersection(const BinarySearchTree& a, const BinarySearchTree& b) {
+        BinarySearchTree result = a.copyKeys();
+        result.intersect_with(b);
+        return result;
+    }
+    
+    static BinarySearchTree set_difference(const BinarySearchTree& a, const BinarySearchTree& b) {
+        BinarySearchTree result = a.copyKeys();
+        result.difference_with(b);
+        return result;
+    }
+    
+    // Iterators
+    [[nodiscard]] Iterator begin() const { return Iterator(findMin(root_), this); }
+    [[nodiscard]] Iterator end() const { return Iterator(nullptr, this); }
     
     // Lookup
     [[nodiscard]] bool contains(const T& value) const {
-        return search(root_, value);
+        instrument::Timer<Instrument> timer(instrument::Operation::Lookup);
+        return search(value);
+    }
+    
+    [[nodiscard]] Iterator find(const T& value) const {
+        return Iterator(findNode(value), this);
+    }
+    
+    // O(log n) on a balanced tree
+    [[nodiscard]] Iterator lower_bound(const T& value) const {
+        return Iterator(lowerBoundNode(value), this);
+    }
+    
+    [[nodiscard]] Iterator upper_bound(const T& value) const {
+        return Iterator(upperBoundNode(value), this);
+    }
+    
+    [[nodiscard]] std::pair<Iterator, Iterator> equal_range(const T& value) const {
+        return {lower_bound(value), upper_bound(value)};
+    }
+    
+    // All keys in the closed interval [lo, hi], yielded lazily in order:
+    // O(log n) to position plus O(1) amortized per element visited
+    [[nodiscard]] Range range(const T& lo, const T& hi) const {
+        if (hi < lo) return Range(end(), end());
+        return Range(lower_bound(lo), upper_bound(hi));
+    }
+    
+    // Order statistics (require augment::SubtreeSize); O(log n) on a balanced tree
+    
+    // Number of keys strictly less than value
+    [[nodiscard]] size_t rank(const T& value) const {
+        static_assert(kCounted, "rank() requires augment::SubtreeSize");
+        size_t result = 0;
+        for (Node* node = root_; node;) {
+            if (node->data < value) {
+                result += nodeCount(node->left) + 1;
+                node = node->right;
+            } else {
+                node = node->left;
+            }
+        }
+        return result;
+    }
+    
+    // The k-th smallest key (0-based), or end() if k >= size()
+    [[nodiscard]] Iterator select(size_t k) const {
+        static_assert(kCounted, "select() requires augment::SubtreeSize");
+        Node* node = root_;
+        while (node) {
+            size_t leftCount = nodeCount(node->left);
+            if (k < leftCount) {
+                node = node->left;
+            } else if (k == leftCount) {
+                break;
+            } else {
+                k -= leftCount + 1;
+                node = node->right;
+            }
+        }
+        return Iterator(node, this);
+    }
+    
+    // Number of keys in the closed interval [lo, hi]
+    [[nodiscard]] size_t count_range(const T& lo, const T& hi) const {
+        static_assert(kCounted, "count_range() requires augment::SubtreeSize");
+        if (hi < lo) return 0;
+        size_t notGreater = 0;
+        for (Node* node = root_; node;) {
+            if (hi < node->data) {
+                node = node->left;
+            } else {
+                notGreater += nodeCount(node->left) + 1;
+                node = node->right;
+            }
+        }
+        return notGreater - rank(lo);
     }
     
     [[nodiscard]] std::optional<T> minimum() const {
@@ -179,19 +1316,19 @@ public:
     // Traversals
     [[nodiscard]] std::vector<T> inorderTraversal() const {
         std::vector<T> result;
-        inorder(root_, result);
+        collect(root_, result, Order::In);
         return result;
     }
     
     [[nodiscard]] std::vector<T> preorderTraversal() const {
         std::vector<T> result;
-        preorder(root_, result);
+        collect(root_, result, Order::Pre);
         return result;
     }
     
     [[nodiscard]] std::vector<T> postorderTraversal() const {
         std::vector<T> result;
-        postorder(root_, result);
+        collect(root_, result, Order::Post);
         return result;
     }
     
@@ -212,9 +1349,34 @@ public:
         return result;
     }
     
+    // Snapshot of the keys in an Eytzinger array for read-heavy use; O(n).
+    // Later changes to this tree do not affect the snapshot.
+    [[nodiscard]] StaticSearchTree<T> freeze() const {
+        return StaticSearchTree<T>(inorderTraversal());
+    }
+    
+    // Write the keys in order (io::Layout::SortedKeys); T trivially copyable
+    void save(const std::filesystem::path& path) const {
+        io::detail::saveElements<T>(path, io::Layout::SortedKeys, begin(), end(), size_);
+    }
+    
+    // Replace the contents with the keys of a file written by save() or by
+    // StaticSearchTree::save(), rebuilt balanced in O(n). Throws
+    // std::runtime_error if the file is unreadable or does not match T.
+    void load(const std::filesystem::path& path) {
+        std::vector<T> values =
+            io::detail::loadElements<T>(path, {io::Layout::SortedKeys, io::Layout::Eytzinger});
+        for (size_t i = 1; i < values.size(); ++i) {
+            if (!(values[i - 1] < values[i])) {
+                throw std::runtime_error(path.string() + ": keys are not strictly increasing");
+            }
+        }
+        buildFrom(values);
+    }
+    
     // Validation
     [[nodiscard]] bool isValid() const {
-        return isValidBST(root_, nullptr, nullptr);
+        return isValidBST(root_);
     }
     
     // Print tree structure
@@ -229,4 +1391,17 @@ public:
     }
 };
 
+// Self-balancing BST with the same API; O(log n) worst case for all lookups
+template <typename T, typename Allocator = std::allocator<T>>
+using BalancedTree = BinarySearchTree<T, balance::AVL, Allocator>;
+
+// Balanced tree with rank/select/count_range in O(log n)
+template <typename T, typename Allocator = std::allocator<T>>
+using OrderStatisticTree = BinarySearchTree<T, balance::AVL, Allocator, augment::SubtreeSize>;
+
+namespace pmr {
+    template <typename T, typename Balance = balance::None>
+    using BinarySearchTree = dsa::BinarySearchTree<T, Balance, std::pmr::polymorphic_allocator<T>>;
+}
+
 } // namespace dsa
@@ -0,0 +1,310 @@
+#pragma once
+
+/**
+ * @file ConcurrentQueue.hpp
+ * @brief Unbounded lock-free multi-producer multi-consumer FIFO queue
+ * @author Neel Patel
+ * @version 1.0.0
+ *
+ * Features:
+ * - Michael-Scott linked queue: push and pop are lock-free, with head and
+ *   tail on separate cache lines
+ * - Dequeued nodes are reclaimed through Epoch, so no hazard pointers
+ * - Nodes are recycled through a per-queue free list and refilled in batches
+ *   from the allocator (e.g. dsa::PoolAllocator), so steady-state traffic
+ *   does not allocate
+ * - push_bulk links a whole batch with a single CAS
+ */
+
+#include "Epoch.hpp"
+#include "NodePool.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <type_traits>
+
+namespace dsa {
+
+template <typename T, typename Allocator = std::allocator<T>>
+class ConcurrentQueue {
+private:
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        alignas(T) unsigned char storage[sizeof(T)];
+        
+        T* value() { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+    
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+    
+    // Owns every node ever allocated. Counts a reference for each node still
+    // waiting in an epoch retire list; the queue's destructor drains those
+    // before freeing the nodes, so the allocator is never used afterwards.
+    struct NodeCache {
+        static constexpr size_t kRefillBatch = 64;
+        
+        std::atomic<Node*> free{nullptr};
+        std::atomic<size_t> refs{1};
+        std::mutex allocMutex; // the allocator need not be thread-safe
+        NodeAllocator alloc;
+        
+        explicit NodeCache(const Allocator& a) : alloc(a) {}
+        
+        ~NodeCache() {
+            for (Node* node = free.load(); node;) {
+                Node* next = node->next.load(std::memory_order_relaxed);
+                node->~Node();
+                NodeTraits::deallocate(alloc, node, 1);
+                node = next;
+            }
+        }
+        
+        // Treiber push of the chain first..last
+        void push(Node* first, Node* last) {
+            Node* head = free.load();
+            do {
+                last->next.store(head, std::memory_order_relaxed);
+            } while (!free.compare_exchange_weak(head, first));
+        }
+        
+        // Caller is pinned: a node it sees on the free list cannot be
+        // popped, used, retired and pushed back within the pin, so the CAS
+        // cannot suffer ABA
+        Node* pop() {
+            Node* head = free.load();
+            while (head && !free.compare_exchange_weak(head, head->next.load())) {}
+            if (head) return head;
+            return refill();
+        }
+        
+        // Allocate a batch, keep one node and publish the rest
+        Node* refill() {
+            std::lock_guard<std::mutex> lock(allocMutex);
+            detail::tryReserve<Node>(alloc, kRefillBatch);
+            Node* first = nullptr;
+            Node* last = nullptr;
+            for (size_t i = 0; i < kRefillBatch; ++i) {
+                Node* node = NodeTraits::allocate(alloc, 1);
+                ::new (static_cast<void*>(node)) Node();
+                node->next.store(first, std::memory_order_relaxed);
+                if (!last) last = node;
+                first = node;
+            }
+            Node* kept = first;
+            Node* rest = first->next.load(std::memory_order_relaxed);
+            if (rest) push(rest, last);
+            kept->next.store(nullptr, std::memory_order_relaxed);
+            return kept;
+        }
+        
+        void release() {
+            if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this;
+        }
+        
+        // Hand node back to the free list once no pinned thread can see it
+        void retire(Node* node) {
+            refs.fetch_add(1, std::memory_order_relaxed);
+            Epoch::retire(node, [](void* p, void* context) {
+                auto* cache = static_cast<NodeCache*>(context);
+                Node* n = static_cast<Node*>(p);
+                cache->push(n, n);
+                cache->release();
+            }, this);
+        }
+    };
+    
+    // All three accessed seq_cst, as Epoch requires
+    alignas(64) std::atomic<Node*> head_;
+    alignas(64) std::atomic<Node*> tail_;
+    NodeCache* cache_;
+    
+    // Node with a constructed value, not yet linked
+    template <typename... Args>
+    Node* makeNode(Args&&... args) {
+        Node* node = cache_->pop();
+        try {
+            ::new (static_cast<void*>(node->storage)) T(std::forward<Args>(args)...);
+        } catch (...) {
+            // Not straight back to the free list: that could create ABA
+            cache_->retire(node);
+            throw;
+        }
+        node->next.store(nullptr, std::memory_order_relaxed);
+        return node;
+    }
+    
+    // Link the chain first..last after the current last node
+    void link(Node* first, Node* last) {
+        while (true) {
+            Node* tail = tail_.load();
+            Node* next = tail->next.load();
+            if (tail != tail_.load()) continue;
+            if (next) {
+                // Tail is lagging: help it along
+                tail_.compare_exchange_strong(tail, next);
+                continue;
+            }
+            if (tail->next.compare_exchange_weak(next, first)) {
+                tail_.compare_exchange_strong(tail, last);
+                return;
+            }
+        }
+    }
+    
+    // Unlink the first value and move it out; false if empty. Caller is pinned.
+    template <typename Out>
+    bool popInto(Out&& out) {
+        while (true) {
+            Node* head = head_.load();
+            Node* tail = tail_.load();
+            Node* next = head->next.load();
+            if (head != head_.load()) continue;
+            if (!next) return false;
+            if (head == tail) {
+                tail_.compare_exchange_strong(tail, next);
+                continue;
+            }
+            if (head_.compare_exchange_strong(head, next)) {
+                // next is the new dummy; only this thread touches its value.
+                // Destroy it and retire the old dummy even if out() throws.
+                struct Release {
+                    T* value;
+                    Node* head;
+                    NodeCache* cache;
+                    ~Release() {
+                        value->~T();
+                        cache->retire(head);
+                    }
+                } release{next->value(), head, cache_};
+                out(std::move(*release.value));
+                return true;
+            }
+        }
+    }
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    
+    ConcurrentQueue() : ConcurrentQueue(Allocator()) {}
+    
+    explicit ConcurrentQueue(const Allocator& alloc) : cache_(new NodeCache(alloc)) {
+        Epoch::Guard guard;
+        Node* dummy = cache_->pop();
+        head_.store(dummy);
+        tail_.store(dummy);
+    }
+    
+    ConcurrentQueue(const ConcurrentQueue&) = delete;
+    ConcurrentQueue& operator=(const ConcurrentQueue&) = delete;
+    
+    // No other thread may use the queue any more, and the calling thread
+    // must not be pinned. Waits for the nodes still in epoch retire lists
+    // (see Epoch::barrier), so every node goes back to the allocator here.
+    ~ConcurrentQueue() {
+        Node* node = head_.load();
+        Node* next = node->next.load();
+        cache_->push(node, node);
+        for (node = next; node; node = next) {
+            next = node->next.load();
+            node->value()->~T();
+            cache_->push(node, node);
+        }
+        if (cache_->refs.load(std::memory_order_acquire) > 1) Epoch::barrier();
+        cache_->release();
+    }
+    
+    // Producers
+    template <typename... Args>
+    void emplace(Args&&... args) {
+        Epoch::Guard guard;
+        Node* node = makeNode(std::forward<Args>(args)...);
+        link(node, node);
+    }
+    
+    void push(const T& value) { emplace(value); }
+    void push(T&& value) { emplace(std::move(value)); }
+    
+    // Never throws: false if the node or the value could not be made
+    bool try_push(const T& value) noexcept {
+        try {
+            push(value);
+            return true;
+        } catch (...) {
+            return false;
+        }
+    }
+    
+    bool try_push(T&& value) noexcept {
+        try {
+            push(std::move(value));
+            return true;
+        } catch (...) {
+            return false;
+        }
+    }
+    
+    // Enqueue [first, last) as one contiguous, atomically visible batch
+    template <typename InputIt>
+    void push_bulk(InputIt first, InputIt last) {
+        Epoch::Guard guard;
+        Node* head = nullptr;
+        Node* tail = nullptr;
+        try {
+            for (; first != last; ++first) {
+                Node* node = makeNode(*first);
+                if (tail) tail->next.store(node, std::memory_order_relaxed);
+                else head = node;
+                tail = node;
+            }
+        } catch (...) {
+            for (Node* node = head; node;) {
+                Node* next = node->next.load(std::memory_order_relaxed);
+                node->value()->~T();
+                cache_->retire(node);
+                node = next;
+            }
+            throw;
+        }
+        if (head) link(head, tail);
+    }
+    
+    // Consumers
+    [[nodiscard]] std::optional<T> try_pop() {
+        Epoch::Guard guard;
+        std::optional<T> result;
+        popInto([&result](T&& value) { result.emplace(std::move(value)); });
+        return result;
+    }
+    
+    bool try_pop(T& out) {
+        Epoch::Guard guard;
+        return popInto([&out](T&& value) { out = std::move(value); });
+    }
+    
+    // Pop up to maxCount values into out under one pin; returns how many
+    template <typename OutputIt>
+    size_t pop_bulk(OutputIt out, size_t maxCount) {
+        Epoch::Guard guard;
+        size_t count = 0;
+        while (count < maxCount && popInto([&out](T&& value) { *out++ = std::move(value); })) ++count;
+        return count;
+    }
+    
+    // A snapshot: may be stale by the time it is used
+    [[nodiscard]] bool empty() const {
+        Epoch::Guard guard;
+        return head_.load()->next.load() == nullptr;
+    }
+};
+
+namespace pmr {
+    template <typename T>
+    using ConcurrentQueue = dsa::ConcurrentQueue<T, std::pmr::polymorphic_allocator<T>>;
+}
+
+} // namespace dsa
@@ -0,0 +1,304 @@
+#pragma once
+
+/**
+ * @file ConcurrentSearchTree.hpp
+ * @brief Linearizable concurrent ordered set with wait-free lookups
+ * @author Neel Patel
+ * @version 1.0.0
+ *
+ * - Nodes are immutable once published: an update copies the O(log n) path
+ *   it changes (AVL-rebalanced) and swings the root with one CAS
+ * - Lookups never lock, retry or write shared memory; they only pin the
+ *   epoch, so read throughput scales with cores
+ * - insert/remove are lock-free: a lost CAS discards the private copy and
+ *   retries against the new root
+ * - Replaced nodes are reclaimed through Epoch once no reader can see them
+ * - Every operation, including snapshot(), sees one consistent version
+ */
+
+#include "Epoch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <optional>
+#include <vector>
+
+namespace dsa {
+
+template <typename T>
+class ConcurrentSearchTree {
+private:
+    struct Node {
+        T key;
+        const Node* left;
+        const Node* right;
+        int height;
+        uint64_t stamp; // id of the update that made it; never read by lookups
+        
+        Node(const T& k, const Node* l, const Node* r, int h, uint64_t s)
+            : key(k), left(l), right(r), height(h), stamp(s) {}
+    };
+    
+    // Private state of one update attempt
+    struct Update {
+        uint64_t id;
+        std::vector<Node*> created;        // unpublished copies
+        std::vector<const Node*> replaced; // nodes left out of the new version
+        
+        explicit Update(uint64_t stamp) : id(stamp) {}
+        
+        // Forget a failed attempt: nothing it made was ever visible
+        void discard(uint64_t nextId) {
+            for (Node* node : created) delete node;
+            created.clear();
+            replaced.clear();
+            id = nextId;
+        }
+    };
+    
+    // Accessed seq_cst throughout, as Epoch requires
+    std::atomic<const Node*> root_{nullptr};
+    std::atomic<size_t> size_{0};
+    
+    static uint64_t nextStamp() {
+        static std::atomic<uint64_t> counter{1};
+        return counter.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    static int nodeHeight(const Node* node) { return node ? node->height : 0; }
+    
+    static const Node* make(Update& u, const T& key, const Node* left, const Node* right) {
+        u.created.push_back(nullptr); // slot first, so a throwing allocation leaks nothing
+        u.created.back() = new Node(key, left, right, 1 + std::max(nodeHeight(left), nodeHeight(right)), u.id);
+        return u.created.back();
+    }
+    
+    // New node over (left, key, right), rotated so the AVL invariant holds;
+    // nodes the rotation takes apart are recorded as replaced
+    static const Node* balance(Update& u, const T& key, const Node* left, const Node* right) {
+        int hl = nodeHeight(left);
+        int hr = nodeHeight(right);
+        if (hl > hr + 1) {
+            u.replaced.push_back(left);
+            if (nodeHeight(left->left) >= nodeHeight(left->right)) {
+                return make(u, left->key, left->left, make(u, key, left->right, right));
+            }
+            const Node* pivot = left->right;
+            u.replaced.push_back(pivot);
+            return make(u, pivot->key, make(u, left->key, left->left, pivot->left),
+                        make(u, key, pivot->right, right));
+        }
+        if (hr > hl + 1) {
+            u.replaced.push_back(right);
+            if (nodeHeight(right->right) >= nodeHeight(right->left)) {
+                return make(u, right->key, make(u, key, left, right->left), right->right);
+            }
+            const Node* pivot = right->left;
+            u.replaced.push_back(pivot);
+            return make(u, pivot->key, make(u, key, left, pivot->left),
+                        make(u, right->key, pivot->right, right->right));
+        }
+        return make(u, key, left, right);
+    }
+    
+    // Path-copying insert; nullptr if value is already present.
+    // Recursion depth is the AVL height, O(log n).
+    static const Node* insertInto(Update& u, const Node* node, const T& value) {
+        if (!node) return make(u, value, nullptr, nullptr);
+        if (value < node->key) {
+            const Node* left = insertInto(u, node->left, value);
+            if (!left) return nullptr;
+            u.replaced.push_back(node);
+            return balance(u, node->key, left, node->right);
+        }
+        if (node->key < value) {
+            const Node* right = insertInto(u, node->right, value);
+            if (!right) return nullptr;
+            u.replaced.push_back(node);
+            return balance(u, node->key, node->left, right);
+        }
+        return nullptr;
+    }
+    
+    static const Node* removeMin(Update& u, const Node* node, const Node*& min) {
+        u.replaced.push_back(node);
+        if (!node->left) {
+            min = node;
+            return node->right;
+        }
+        const Node* left = removeMin(u, node->left, min);
+        return balance(u, node->key, left, node->right);
+    }
+    
+    // Path-copying remove; returns node itself when value is absent
+    static const Node* removeFrom(Update& u, const Node* node, const T& value, bool& found) {
+        if (!node) return nullptr;
+        if (value < node->key) {
+            const Node* left = removeFrom(u, node->left, value, found);
+            if (!found) return node;
+            u.replaced.push_back(node);
+            return balance(u, node->key, left, node->right);
+        }
+        if (node->key < value) {
+            const Node* right = removeFrom(u, node->right, value, found);
+            if (!found) return node;
+            u.replaced.push_back(node);
+            return balance(u, node->key, node->left, right);
+        }
+        found = true;
+        u.replaced.push_back(node);
+        if (!node->left) return node->right;
+        if (!node->right) return node->left;
+        const Node* min = nullptr;
+        const Node* right = removeMin(u, node->right, min);
+        return balance(u, min->key, node->left, right);
+    }
+    
+    // Publish `updated` if the root is still `expected` (the linearization
+    // point). Replaced nodes that were published before are retired; copies
+    // this update made and then replaced itself are freed at once.
+    bool commit(const Node* expected, const Node* updated, Update& u) {
+        if (!root_.compare_exchange_strong(expected, updated)) {
+            return false;
+        }
+        for (const Node* node : u.replaced) {
+            if (node->stamp == u.id) delete node;
+            else Epoch::retire(const_cast<Node*>(node));
+        }
+        return true;
+    }
+    
+    // Run an update attempt against the current root until one commits.
+    // attempt(u, root) returns {new root, changed}; unchanged means no-op.
+    template <typename Attempt>
+    bool update(Attempt attempt) {
+        Epoch::Guard guard;
+        Update u(nextStamp());
+        while (true) {
+            const Node* root = root_.load();
+            std::pair<const Node*, bool> result;
+            try {
+                result = attempt(u, root);
+            } catch (...) {
+                u.discard(0);
+                throw;
+            }
+            if (!result.second) return false;
+            if (commit(root, result.first, u)) return true;
+            u.discard(nextStamp());
+        }
+    }
+    
+    // Free a whole version; only safe when no other thread can reach it
+    static void destroy(const Node* root) {
+        std::vector<const Node*> stack;
+        if (root) stack.push_back(root);
+        while (!stack.empty()) {
+            const Node* node = stack.back();
+            stack.pop_back();
+            if (node->left) stack.push_back(node->left);
+            if (node->right) stack.push_back(node->right);
+            delete node;
+        }
+    }
+
+public:
+    using value_type = T;
+    
+    ConcurrentSearchTree() = default;
+    
+    ConcurrentSearchTree(std::initializer_list<T> init) {
+        for (const auto& item : init) insert(item);
+    }
+    
+    ConcurrentSearchTree(const ConcurrentSearchTree&) = delete;
+    ConcurrentSearchTree& operator=(const ConcurrentSearchTree&) = delete;
+    
+    // No other thread may use the tree any more
+    ~ConcurrentSearchTree() { destroy(root_.load()); }
+    
+    // Capacity (exact once concurrent updates have finished)
+    [[nodiscard]] size_t size() const { return size_.load(std::memory_order_relaxed); }
+    [[nodiscard]] bool empty() const { return root_.load() == nullptr; }
+    
+    // Modifiers; true if the set changed
+    bool insert(const T& value) {
+        bool inserted = update([&value](Update& u, const Node* root) {
+            const Node* updated = insertInto(u, root, value);
+            return std::make_pair(updated, updated != nullptr);
+        });
+        if (inserted) size_.fetch_add(1, std::memory_order_relaxed);
+        return inserted;
+    }
+    
+    bool remove(const T& value) {
+        bool removed = update([&value](Update& u, const Node* root) {
+            bool found = false;
+            const Node* updated = removeFrom(u, root, value, found);
+            return std::make_pair(updated, found);
+        });
+        if (removed) size_.fetch_sub(1, std::memory_order_relaxed);
+        return removed;
+    }
+    
+    // Remove everything; concurrent readers keep seeing the old version
+    void clear() {
+        Epoch::Guard guard;
+        const Node* old = root_.exchange(nullptr);
+        std::vector<const Node*> stack;
+        if (old) stack.push_back(old);
+        size_t count = 0;
+        while (!stack.empty()) {
+            const Node* node = stack.back();
+            stack.pop_back();
+            if (node->left) stack.push_back(node->left);
+            if (node->right) stack.push_back(node->right);
+            Epoch::retire(const_cast<Node*>(node));
+            ++count;
+        }
+        // Not a store of 0: updates that committed before the exchange may
+        // not have adjusted size_ yet
+        size_.fetch_sub(count, std::memory_order_relaxed);
+    }
+    
+    // Wait-free: O(log n) steps whatever the writers do
+    [[nodiscard]] bool contains(const T& value) const {
+        Epoch::Guard guard;
+        const Node* node = root_.load();
+        while (node) {
+            if (value < node->key) node = node->left;
+            else if (node->key < value) node = node->right;
+            else return true;
+        }
+        return false;
+    }
+    
+    // Smallest key >= value
+    [[nodiscard]] std::optional<T> lower_bound(const T& value) const {
+        Epoch::Guard guard;
+        const Node* result = nullptr;
+        for (const Node* node = root_.load(); node;) {
+            if (node->key < value) node = node->right;
+            else { result = node; node = node->left; }
+        }
+        return result ? std::optional<T>(result->key) : std::nullopt;
+    }
+    
+    // All keys of one version, in order
+    [[nodiscard]] std::vector<T> snapshot() const {
+        Epoch::Guard guard;
+        std::vector<T> result;
+        std::vector<const Node*> stack;
+        const Node* node = root_.load();
+        while (node || !stack.empty()) {
+            for (; node; node = node->left) stack.push_back(node);
+            node = stack.back();
+            stack.pop_back();
+            result.push_back(node->key);
+            node = node->right;
+        }
+        return result;
+    }
+};
+
+} // namespace dsa
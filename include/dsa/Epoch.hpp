@@ -0,0 +1,253 @@
+#pragma once
+
+/**
+ * @file Epoch.hpp
+ * @brief Epoch-based memory reclamation for lock-free containers
+ * @author Neel Patel
+ * @version 1.0.0
+ *
+ * A thread pins the current epoch (Epoch::Guard) while it may dereference
+ * shared nodes. A node unlinked by a writer is retired instead of deleted,
+ * and is freed once the global epoch has advanced twice: by then every
+ * thread that could still have seen it has unpinned.
+ *
+ * - Pinning is one atomic exchange on a thread-private cache line
+ * - Containers must load shared pointers with memory_order_seq_cst (a plain
+ *   load on x86, ldar on AArch64) so they cannot move ahead of the pin
+ * - Retired nodes are buffered per thread and freed in batches
+ * - Threads register on first use; their leftovers are handed over on exit
+ * - barrier() waits out a grace period and frees everything retired so far,
+ *   on every thread, so a container can tear down its node storage
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace dsa {
+
+class Epoch {
+    struct Record;
+
+public:
+    // Keeps the calling thread pinned for its lifetime; nests freely
+    class Guard {
+    public:
+        Guard() : record_(Epoch::local()) { Epoch::enter(record_); }
+        ~Guard() { Epoch::leave(record_); }
+        
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+    
+    private:
+        Record* record_;
+    };
+    
+    // Free p with `delete` once no pinned thread can still reach it
+    template <typename T>
+    static void retire(T* p) {
+        retire(p, [](void* q, void*) { delete static_cast<T*>(q); }, nullptr);
+    }
+    
+    // Call deleter(p, context) once no pinned thread can still reach p;
+    // e.g. to recycle p into a container-owned free list
+    static void retire(void* p, void (*deleter)(void*, void*), void* context) {
+        Record* record = local();
+        size_t pending;
+        {
+            ListLock lock(record);
+            record->retired.push_back({p, context, deleter, instance().epoch.load()});
+            pending = record->retired.size();
+        }
+        if (pending >= kCollectThreshold) collect(record);
+    }
+    
+    // Try to advance the epoch and free what has become unreachable
+    static void collect() { collect(local()); }
+    
+    // Wait until the epoch has advanced twice, then free every entry that
+    // was retired before the call, whichever thread retired it. Blocks while
+    // other threads stay pinned; the calling thread must not be pinned.
+    static void barrier() {
+        Domain& domain = instance();
+        uint64_t target = domain.epoch.load() + 2;
+        uint64_t now;
+        while ((now = tryAdvance()) < target) std::this_thread::yield();
+        for (Record* r = domain.records.load(std::memory_order_acquire); r; r = r->next) {
+            freeExpired(r, now);
+        }
+        std::vector<Retired> expired;
+        {
+            std::lock_guard<std::mutex> lock(domain.orphansMutex);
+            takeExpired(domain.orphans, now, expired);
+        }
+        for (Retired& r : expired) r.release();
+    }
+
+private:
+    static constexpr uint64_t kIdle = ~uint64_t(0);
+    static constexpr size_t kCollectThreshold = 128;
+    
+    struct Retired {
+        void* pointer;
+        void* context;
+        void (*deleter)(void*, void*);
+        uint64_t epoch;
+        
+        void release() const { deleter(pointer, context); }
+    };
+    
+    // One per thread, cache-line sized so pinning never shares a line
+    struct alignas(64) Record {
+        std::atomic<uint64_t> epoch{kIdle};
+        std::atomic<bool> inUse{true};
+        std::atomic<bool> retiredBusy{false}; // guards retired against barrier()
+        Record* next = nullptr;
+        unsigned nesting = 0;
+        std::vector<Retired> retired;
+    };
+    
+    // Spin lock on a record's retire list; only barrier() ever contends
+    class ListLock {
+    public:
+        explicit ListLock(Record* record) : record_(record) {
+            while (record_->retiredBusy.exchange(true, std::memory_order_acquire)) std::this_thread::yield();
+        }
+        ~ListLock() { record_->retiredBusy.store(false, std::memory_order_release); }
+        
+        ListLock(const ListLock&) = delete;
+        ListLock& operator=(const ListLock&) = delete;
+    
+    private:
+        Record* record_;
+    };
+    
+    struct Domain {
+        std::atomic<uint64_t> epoch{0};
+        std::atomic<Record*> records{nullptr};
+        std::mutex orphansMutex;
+        std::vector<Retired> orphans; // left behind by exited threads
+        
+        ~Domain() {
+            // Static destruction: no thread is pinned any more
+            for (Retired& r : orphans) r.release();
+            for (Record* record = records.load(); record;) {
+                Record* next = record->next;
+                for (Retired& r : record->retired) r.release();
+                delete record;
+                record = next;
+            }
+        }
+    };
+    
+    // Hands the thread's record back when the thread exits
+    struct LocalHandle {
+        Record* record;
+        
+        LocalHandle() : record(acquire()) {}
+        
+        ~LocalHandle() {
+            Domain& domain = instance();
+            collect(record);
+            ListLock listLock(record);
+            {
+                std::lock_guard<std::mutex> lock(domain.orphansMutex);
+                domain.orphans.insert(domain.orphans.end(), record->retired.begin(), record->retired.end());
+            }
+            record->retired.clear();
+            record->epoch.store(kIdle, std::memory_order_release);
+            record->inUse.store(false, std::memory_order_release);
+        }
+    };
+    
+    static Domain& instance() {
+        static Domain domain;
+        return domain;
+    }
+    
+    static Record* local() {
+        static thread_local LocalHandle handle;
+        return handle.record;
+    }
+    
+    // Reuse the record of an exited thread, or push a new one
+    static Record* acquire() {
+        Domain& domain = instance();
+        for (Record* r = domain.records.load(std::memory_order_acquire); r; r = r->next) {
+            bool free = false;
+            if (!r->inUse.load(std::memory_order_relaxed) &&
+                r->inUse.compare_exchange_strong(free, true, std::memory_order_acquire)) {
+                return r;
+            }
+        }
+        Record* record = new Record();
+        Record* head = domain.records.load(std::memory_order_relaxed);
+        do {
+            record->next = head;
+        } while (!domain.records.compare_exchange_weak(head, record, std::memory_order_release,
+                                                       std::memory_order_relaxed));
+        return record;
+    }
+    
+    static void enter(Record* record) {
+        if (record->nesting++ > 0) return;
+        // Sequentially consistent, like the shared-pointer loads that follow:
+        // the pin is visible before any of them
+        record->epoch.exchange(instance().epoch.load(), std::memory_order_seq_cst);
+    }
+    
+    static void leave(Record* record) {
+        if (--record->nesting > 0) return;
+        record->epoch.store(kIdle, std::memory_order_release);
+    }
+    
+    // The epoch may move on once every pinned thread has seen the current one
+    static uint64_t tryAdvance() {
+        Domain& domain = instance();
+        uint64_t current = domain.epoch.load();
+        for (Record* r = domain.records.load(std::memory_order_acquire); r; r = r->next) {
+            uint64_t seen = r->epoch.load();
+            if (seen != kIdle && seen != current) return current;
+        }
+        domain.epoch.compare_exchange_strong(current, current + 1);
+        return domain.epoch.load();
+    }
+    
+    // Move every entry retired at least two epochs ago from list to expired
+    static void takeExpired(std::vector<Retired>& list, uint64_t now, std::vector<Retired>& expired) {
+        size_t kept = 0;
+        for (Retired& r : list) {
+            if (r.epoch + 2 <= now) expired.push_back(r);
+            else list[kept++] = r;
+        }
+        list.resize(kept);
+    }
+    
+    // Deleters run outside the lock, so they may retire in turn
+    static void freeExpired(Record* record, uint64_t now) {
+        std::vector<Retired> expired;
+        {
+            ListLock lock(record);
+            takeExpired(record->retired, now, expired);
+        }
+        for (Retired& r : expired) r.release();
+    }
+    
+    static void collect(Record* record) {
+        Domain& domain = instance();
+        uint64_t now = tryAdvance();
+        freeExpired(record, now);
+        std::vector<Retired> expired;
+        {
+            std::unique_lock<std::mutex> lock(domain.orphansMutex, std::try_to_lock);
+            if (lock.owns_lock()) takeExpired(domain.orphans, now, expired);
+        }
+        for (Retired& r : expired) r.release();
+    }
+};
+
+} // namespace dsa
@@ -0,0 +1,453 @@
+#pragma once
+
+/**
+ * @file ExternalSort.hpp
+ * @brief Out-of-core merge sort for files and streams of trivially copyable T
+ * @author Neel Patel
+ * @version 1.0.0
+ *
+ * 1. Run formation: read as many elements as the memory budget allows,
+ *    sort them with the in-memory engine (quickSort), spill to a temp file
+ * 2. Merge: k-way merge of the runs through a loser tree. Every run is read
+ *    with double-buffered read-ahead, and stream output uses write-behind;
+ *    both queue their block I/O on a ThreadPool instead of starting threads.
+ *    Runs that exceed the fan-in the budget allows are merged in several
+ *    passes.
+ *
+ * File inputs and outputs are memory-mapped on POSIX systems. Input that
+ * fits in the budget is sorted in memory without touching the disk.
+ * Elements are raw binary T (native byte order). The sort is not stable.
+ */
+
+#include "MappedFile.hpp"
+#include "Sorting.hpp"
+#include "ThreadPool.hpp"
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace dsa {
+namespace sort {
+
+struct ExternalSortOptions {
+    // Upper bound for run buffers plus merge buffers, in bytes
+    size_t memoryBudget = size_t(256) << 20;
+    // Where runs are spilled; empty means the system temp directory
+    std::filesystem::path tempDirectory;
+    // Pool for read-ahead and write-behind; nullptr means ThreadPool::global()
+    ThreadPool* threadPool = nullptr;
+};
+
+struct ExternalSortStats {
+    size_t elements = 0;
+    size_t runs = 0;        // runs spilled to disk (0 when sorted in memory)
+    size_t mergePasses = 0; // sweeps over the spilled data, including the final merge
+};
+
+namespace detail {
+    // Merge blocks smaller than this are not worth a read; beyond the fan-in
+    // that leaves, runs are merged in several passes. Tiny budgets still
+    // merge at least kMinFanIn runs at a time, with smaller blocks.
+    constexpr size_t kMinMergeBlockBytes = size_t(64) << 10;
+    constexpr size_t kMinFanIn = 16;
+    
+    // Temp file removed when the owner goes away
+    class TempRun {
+    public:
+        TempRun(const std::filesystem::path& dir, size_t count) : count_(count) {
+            static std::atomic<unsigned> counter{0};
+            static const unsigned salt = std::random_device{}();
+            path_ = dir / ("dsa-sort-" + std::to_string(salt) + "-" +
+                           std::to_string(counter.fetch_add(1)) + ".run");
+        }
+        
+        TempRun(const TempRun&) = delete;
+        TempRun& operator=(const TempRun&) = delete;
+        
+        ~TempRun() {
+            std::error_code ignored;
+            std::filesystem::remove(path_, ignored);
+        }
+        
+        [[nodiscard]] const std::filesystem::path& path() const { return path_; }
+        [[nodiscard]] size_t count() const { return count_; }
+    
+    private:
+        std::filesystem::path path_;
+        size_t count_;
+    };
+    
+    // Sequential reader of one run: the next block is read on the pool
+    // while the merge consumes the current one
+    template <typename T>
+    class RunReader {
+    public:
+        RunReader(const TempRun& run, size_t blockElems, ThreadPool& pool)
+            : file_(run.path(), std::ios::binary), remaining_(run.count()),
+              current_(blockElems), next_(blockElems), pending_(pool) {
+            if (!file_) throw std::runtime_error("cannot open run " + run.path().string());
+            schedule();
+            advanceBlock();
+        }
+        
+        [[nodiscard]] bool empty() const { return pos_ == size_; }
+        [[nodiscard]] const T& head() const { return current_[pos_]; }
+        
+        void pop() {
+            if (++pos_ == size_) advanceBlock();
+        }
+    
+    private:
+        void schedule() {
+            if (remaining_ == 0) return;
+            size_t n = std::min(remaining_, next_.size());
+            remaining_ -= n;
+            scheduled_ = n;
+            pending_.run([this, n] {
+                file_.read(reinterpret_cast<char*>(next_.data()),
+                           static_cast<std::streamsize>(n * sizeof(T)));
+                if (!file_) throw std::runtime_error("short read from run file");
+            });
+        }
+        
+        void advanceBlock() {
+            pos_ = 0;
+            size_ = 0;
+            if (scheduled_ == 0) return;
+            pending_.wait();
+            size_ = std::exchange(scheduled_, 0);
+            std::swap(current_, next_);
+            schedule();
+        }
+        
+        std::ifstream file_;
+        size_t remaining_;
+        std::vector<T> current_;
+        std::vector<T> next_;
+        size_t pos_ = 0;
+        size_t size_ = 0;
+        size_t scheduled_ = 0; // elements of the read in flight
+        TaskGroup pending_;    // declared last: joined before the buffers go
+    };
+    
+    // Tournament tree over k sources whose internal nodes hold the loser of
+    // each match; the overall winner sits in node 0. Advancing the winner
+    // replays only its leaf-to-root path: log2(k) comparisons per element.
+    template <typename Source, typename Compare>
+    class LoserTree {
+    public:
+        LoserTree(std::vector<Source*> sources, Compare comp)
+            : sources_(std::move(sources)), tree_(sources_.size()), comp_(comp) {
+            size_t k = sources_.size();
+            if (k == 1) return;
+            std::vector<size_t> winners(2 * k);
+            for (size_t i = 0; i < k; ++i) winners[k + i] = i;
+            for (size_t node = k - 1; node > 0; --node) {
+                size_t a = winners[2 * node];
+                size_t b = winners[2 * node + 1];
+                bool aWins = beats(a, b);
+                winners[node] = aWins ? a : b;
+                tree_[node] = aWins ? b : a;
+            }
+            tree_[0] = winners[1];
+        }
+        
+        [[nodiscard]] bool empty() const { return sources_[tree_[0]]->empty(); }
+        [[nodiscard]] Source& top() const { return *sources_[tree_[0]]; }
+        
+        // Call after top() advanced
+        void replay() {
+            size_t winner = tree_[0];
+            for (size_t node = (winner + sources_.size()) / 2; node > 0; node /= 2) {
+                if (beats(tree_[node], winner)) std::swap(tree_[node], winner);
+            }
+            tree_[0] = winner;
+        }
+    
+    private:
+        // Exhausted sources lose every match
+        bool beats(size_t a, size_t b) const {
+            if (sources_[a]->empty()) return false;
+            if (sources_[b]->empty()) return true;
+            return comp_(sources_[a]->head(), sources_[b]->head());
+        }
+        
+        std::vector<Source*> sources_;
+        std::vector<size_t> tree_;
+        Compare comp_;
+    };
+    
+    // Output with write-behind: one block is written on the pool while the
+    // next one fills
+    template <typename T>
+    class StreamSink {
+    public:
+        StreamSink(std::ostream& out, size_t blockElems, ThreadPool& pool)
+            : out_(out), capacity_(blockElems), pending_(pool) {
+            buffer_.reserve(capacity_);
+            spare_.reserve(capacity_);
+        }
+        
+        StreamSink(const StreamSink&) = delete;
+        StreamSink& operator=(const StreamSink&) = delete;
+        
+        void put(const T& value) {
+            buffer_.push_back(value);
+            if (buffer_.size() == capacity_) flushAsync();
+        }
+        
+        void finish() {
+            flushAsync();
+            wait();
+            out_.flush();
+            if (!out_) throw std::runtime_error("write to sort output failed");
+        }
+    
+    private:
+        void wait() { pending_.wait(); }
+        
+        void flushAsync() {
+            wait();
+            if (buffer_.empty()) return;
+            std::swap(buffer_, spare_);
+            buffer_.clear();
+            pending_.run([this] {
+                out_.write(reinterpret_cast<const char*>(spare_.data()),
+                           static_cast<std::streamsize>(spare_.size() * sizeof(T)));
+            });
+        }
+        
+        std::ostream& out_;
+        size_t capacity_;
+        std::vector<T> buffer_;
+        std::vector<T> spare_;
+        TaskGroup pending_; // declared last: joined before the buffers go
+    };
+    
+    // Output straight into memory, e.g. a mapped output file
+    template <typename T>
+    class MemorySink {
+    public:
+        explicit MemorySink(T* out) : out_(out) {}
+        void put(const T& value) { *out_++ = value; }
+        void finish() {}
+    
+    private:
+        T* out_;
+    };
+    
+    template <typename T, typename Compare>
+    class ExternalSorter {
+        static_assert(std::is_trivially_copyable_v<T>, "externalSort needs trivially copyable elements");
+    
+    public:
+        ExternalSorter(Compare comp, const ExternalSortOptions& options)
+            : comp_(comp), budget_(std::max<size_t>(options.memoryBudget, 1 << 16)),
+              dir_(options.tempDirectory.empty() ? std::filesystem::temp_directory_path()
+                                                 : options.tempDirectory),
+              pool_(options.threadPool ? *options.threadPool : ThreadPool::global()) {}
+        
+        // Elements that fit in one run buffer
+        [[nodiscard]] size_t runCapacity() const { return std::max<size_t>(budget_ / sizeof(T), 1); }
+        
+        // Write-behind block size for the final merge pass
+        [[nodiscard]] size_t outputBlockElems() const { return blockElems(std::min(runs_.size(), maxFanIn())); }
+        
+        // Sort a chunk in place and spill it as a run
+        void addRun(T* data, size_t n) {
+            detail::introSort(data, data + n, comp_);
+            auto run = std::make_unique<TempRun>(dir_, n);
+            std::ofstream out(run->path(), std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(n * sizeof(T)));
+            out.close();
+            if (!out) throw std::runtime_error("cannot write run " + run->path().string());
+            runs_.push_back(std::move(run));
+            stats_.elements += n;
+            ++stats_.runs;
+        }
+        
+        // Merge every spilled run into sink
+        template <typename Sink>
+        void merge(Sink& sink) {
+            size_t fanIn = maxFanIn();
+            // Runs of the current pass not yet merged; the pass ends when
+            // every run that existed at its start has been consumed
+            size_t passLeft = runs_.size();
+            // Intermediate passes merge the oldest runs into a new one
+            while (runs_.size() > fanIn) {
+                std::vector<std::unique_ptr<TempRun>> group;
+                for (size_t i = 0; i < fanIn; ++i) group.push_back(std::move(runs_[i]));
+                runs_.erase(runs_.begin(), runs_.begin() + fanIn);
+                passLeft -= std::min(passLeft, fanIn);
+                
+                size_t total = 0;
+                for (const auto& run : group) total += run->count();
+                auto merged = std::make_unique<TempRun>(dir_, total);
+                std::ofstream out(merged->path(), std::ios::binary | std::ios::trunc);
+                StreamSink<T> spill(out, blockElems(group.size()), pool_);
+                mergeGroup(group, spill);
+                runs_.push_back(std::move(merged));
+                if (passLeft == 0) {
+                    ++stats_.mergePasses;
+                    passLeft = runs_.size();
+                }
+            }
+            mergeGroup(runs_, sink);
+            ++stats_.mergePasses;
+            runs_.clear();
+        }
+        
+        [[nodiscard]] ExternalSortStats& stats() { return stats_; }
+        [[nodiscard]] Compare& comp() { return comp_; }
+        [[nodiscard]] ThreadPool& pool() const { return pool_; }
+    
+    private:
+        size_t maxFanIn() const { return std::max(kMinFanIn, budget_ / (2 * kMinMergeBlockBytes)); }
+        
+        // Two read buffers per input plus two for the output
+        size_t blockElems(size_t fanIn) const {
+            return std::max<size_t>(budget_ / (2 * (fanIn + 1) * sizeof(T)), 1);
+        }
+        
+        template <typename Sink>
+        void mergeGroup(const std::vector<std::unique_ptr<TempRun>>& group, Sink& sink) {
+            size_t block = blockElems(group.size());
+            std::vector<std::unique_ptr<RunReader<T>>> readers;
+            std::vector<RunReader<T>*> sources;
+            for (const auto& run : group) {
+                readers.push_back(std::make_unique<RunReader<T>>(*run, block, pool_));
+                sources.push_back(readers.back().get());
+            }
+            LoserTree<RunReader<T>, Compare> tree(std::move(sources), comp_);
+            while (!tree.empty()) {
+                RunReader<T>& source = tree.top();
+                sink.put(source.head());
+                source.pop();
+                tree.replay();
+            }
+            sink.finish();
+        }
+        
+        Compare comp_;
+        size_t budget_;
+        std::filesystem::path dir_;
+        ThreadPool& pool_;
+        std::vector<std::unique_ptr<TempRun>> runs_;
+        ExternalSortStats stats_;
+    };
+    
+    // Fill buffer with up to capacity elements, growing it geometrically so
+    // small inputs never allocate the whole budget; returns how many arrived
+    template <typename T>
+    size_t readRun(std::istream& in, std::vector<T>& buffer, size_t capacity) {
+        size_t n = 0;
+        while (n < capacity && in) {
+            if (n == buffer.size()) buffer.resize(std::min(capacity, std::max<size_t>(2 * n, 4096)));
+            in.read(reinterpret_cast<char*>(buffer.data() + n),
+                    static_cast<std::streamsize>((buffer.size() - n) * sizeof(T)));
+            auto bytes = static_cast<size_t>(in.gcount());
+            if (bytes % sizeof(T) != 0) throw std::invalid_argument("input ends inside an element");
+            n += bytes / sizeof(T);
+        }
+        return n;
+    }
+}
+
+// External sort of binary T records from `in` to `out`
+template <typename T, typename Compare = std::less<T>>
+ExternalSortStats externalSort(std::istream& in, std::ostream& out, Compare comp = Compare(),
+                               const ExternalSortOptions& options = ExternalSortOptions()) {
+    detail::ExternalSorter<T, Compare> sorter(comp, options);
+    std::vector<T> buffer;
+    
+    size_t n = detail::readRun(in, buffer, sorter.runCapacity());
+    if (n < sorter.runCapacity()) {
+        // Everything fits: sort in memory, no spill
+        detail::introSort(buffer.data(), buffer.data() + n, sorter.comp());
+        out.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(n * sizeof(T)));
+        if (!out) throw std::runtime_error("write to sort output failed");
+        sorter.stats().elements = n;
+        return sorter.stats();
+    }
+    while (n > 0) {
+        sorter.addRun(buffer.data(), n);
+        n = detail::readRun(in, buffer, sorter.runCapacity());
+    }
+    std::vector<T>().swap(buffer); // give the run buffer back to the merge
+    
+    detail::StreamSink<T> sink(out, sorter.outputBlockElems(), sorter.pool());
+    sorter.merge(sink);
+    return sorter.stats();
+}
+
+// External sort of the binary file `input` into `output`; output may be
+// the input file itself, which is then sorted in place
+template <typename T, typename Compare = std::less<T>>
+ExternalSortStats externalSort(const std::filesystem::path& input, const std::filesystem::path& output,
+                               Compare comp = Compare(),
+                               const ExternalSortOptions& options = ExternalSortOptions()) {
+    std::error_code ec;
+    bool inPlace = std::filesystem::equivalent(input, output, ec);
+#if defined(DSA_HAS_MMAP)
+    MappedFile in(input, inPlace ? MappedFile::Mode::Update : MappedFile::Mode::Read);
+    if (in.size() % sizeof(T) != 0) throw std::invalid_argument("input size is not a multiple of sizeof(T)");
+    size_t n = in.size() / sizeof(T);
+    in.adviseSequential();
+    const T* src = reinterpret_cast<const T*>(in.data());
+    
+    // In place, runs are spilled before the merge overwrites the input
+    std::unique_ptr<MappedFile> out;
+    T* dst = reinterpret_cast<T*>(in.data());
+    if (!inPlace) {
+        out = std::make_unique<MappedFile>(output, MappedFile::Mode::ReadWrite, in.size());
+        dst = reinterpret_cast<T*>(out->data());
+    }
+    
+    detail::ExternalSorter<T, Compare> sorter(comp, options);
+    if (n <= sorter.runCapacity()) {
+        // Fits in the budget: sort the output mapping directly
+        if (!inPlace) std::copy(src, src + n, dst);
+        detail::introSort(dst, dst + n, sorter.comp());
+        sorter.stats().elements = n;
+        return sorter.stats();
+    }
+    
+    {
+        std::vector<T> buffer(sorter.runCapacity());
+        for (size_t offset = 0; offset < n; offset += buffer.size()) {
+            size_t count = std::min(buffer.size(), n - offset);
+            std::copy(src + offset, src + offset + count, buffer.data());
+            sorter.addRun(buffer.data(), count);
+        }
+    }
+    detail::MemorySink<T> sink(dst);
+    sorter.merge(sink);
+    return sorter.stats();
+#else
+    // Truncating the output would destroy an in-place input: sort into a
+    // sibling file and rename it over the input
+    std::filesystem::path target = inPlace ? std::filesystem::path(output.string() + ".sorting") : output;
+    ExternalSortStats stats;
+    {
+        std::ifstream in(input, std::ios::binary);
+        std::ofstream out(target, std::ios::binary | std::ios::trunc);
+        if (!in || !out) throw std::runtime_error("cannot open sort input or output");
+        stats = externalSort<T>(in, out, comp, options);
+    }
+    if (inPlace) std::filesystem::rename(target, output);
+    return stats;
+#endif
+}
+
+} // namespace sort
+} // namespace dsa
@@ -0,0 +1,393 @@
+#pragma once
+
+/**
+ * @file HashIndex.hpp
+ * @brief Open-addressing hash index in the Swiss-table layout
+ * @author Neel Patel
+ * @version 1.0.0
+ *
+ * Features:
+ * - One control byte per slot (7 bits of the hash, or empty/deleted) kept
+ *   apart from the slots, so one probe step tests a group of 16 slots
+ * - Group matching with SSE2 on x86 and NEON on AArch64, scalar code
+ *   elsewhere (define DSA_NO_SIMD to force it)
+ * - Maximum load factor 7/8; an erased slot becomes empty again unless its
+ *   group has filled up, so tombstones only build up under heavy churn
+ * - Stores small trivially copyable slots (pointers, list iterators) and
+ *   reads each slot's key through KeyOf, so keys are never duplicated
+ *
+ * Used by IndexedList.hpp; the table itself is a building block, not a map.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if !defined(DSA_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#define DSA_HASH_SSE2 1
+#include <emmintrin.h>
+#elif !defined(DSA_NO_SIMD) && defined(__aarch64__) && defined(__ARM_NEON)
+#define DSA_HASH_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace dsa {
+namespace detail {
+
+    inline constexpr size_t kGroupWidth = 16;
+    
+    // Control bytes: full slots hold the low 7 hash bits (high bit clear)
+    inline constexpr int8_t kCtrlEmpty = -128;  // 0x80
+    inline constexpr int8_t kCtrlDeleted = -2;  // 0xFE
+    
+    inline unsigned lowestBit(uint64_t bits) {
+#if defined(__GNUC__)
+        return static_cast<unsigned>(__builtin_ctzll(bits));
+#else
+        unsigned i = 0;
+        while (!(bits & 1)) { bits >>= 1; ++i; }
+        return i;
+#endif
+    }
+    
+    // Matching slots of a group: one bit per slot, 2^Shift bits apart
+    template <unsigned Shift>
+    class GroupMask {
+    public:
+        explicit GroupMask(uint64_t bits) : bits_(bits) {}
+        
+        explicit operator bool() const { return bits_ != 0; }
+        [[nodiscard]] size_t lowest() const { return lowestBit(bits_) >> Shift; }
+        void dropLowest() { bits_ &= bits_ - 1; }
+    
+    private:
+        uint64_t bits_;
+    };
+    
+    // 16 control bytes, loaded once per probe step
+    class Group {
+    public:
+#if defined(DSA_HASH_NEON)
+        using Mask = GroupMask<2>;  // 4 bits per slot
+#else
+        using Mask = GroupMask<0>;
+#endif
+
+        explicit Group(const int8_t* ctrl) {
+#if defined(DSA_HASH_SSE2)
+            ctrl_ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+#elif defined(DSA_HASH_NEON)
+            ctrl_ = vld1q_s8(ctrl);
+#else
+            std::memcpy(ctrl_, ctrl, kGroupWidth);
+#endif
+        }
+        
+        // Slots whose control byte equals h2 (or any other control value)
+        [[nodiscard]] Mask match(int8_t h2) const {
+#if defined(DSA_HASH_SSE2)
+            return Mask(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl_, _mm_set1_epi8(h2)))));
+#elif defined(DSA_HASH_NEON)
+            return Mask(nibbles(vceqq_s8(ctrl_, vdupq_n_s8(h2))));
+#else
+            uint64_t bits = 0;
+            for (size_t i = 0; i < kGroupWidth; ++i) bits |= uint64_t(ctrl_[i] == h2) << i;
+            return Mask(bits);
+#endif
+        }
+        
+        [[nodiscard]] Mask matchEmpty() const { return match(kCtrlEmpty); }
+        
+        // Empty and deleted slots: the ones with the high bit set
+        [[nodiscard]] Mask matchFree() const {
+#if defined(DSA_HASH_SSE2)
+            return Mask(static_cast<uint32_t>(_mm_movemask_epi8(ctrl_)));
+#elif defined(DSA_HASH_NEON)
+            return Mask(nibbles(vcltzq_s8(ctrl_)));
+#else
+            uint64_t bits = 0;
+            for (size_t i = 0; i < kGroupWidth; ++i) bits |= uint64_t(ctrl_[i] < 0) << i;
+            return Mask(bits);
+#endif
+        }
+    
+    private:
+#if defined(DSA_HASH_SSE2)
+        __m128i ctrl_;
+#elif defined(DSA_HASH_NEON)
+        int8x16_t ctrl_;
+        
+        // NEON has no movemask: narrow each byte lane to a nibble and keep
+        // one bit of it, so dropLowest() clears a whole slot
+        static uint64_t nibbles(uint8x16_t eq) {
+            uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(eq), 4);
+            return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) & 0x8888888888888888ull;
+        }
+#else
+        int8_t ctrl_[kGroupWidth];
+#endif
+    };
+    
+    // Spread the bits of a (possibly identity) std::hash; murmur3 finalizer
+    inline uint64_t mixHash(uint64_t h) {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ull;
+        h ^= h >> 33;
+        return h;
+    }
+
+} // namespace detail
+
+template <typename Slot, typename KeyOf, typename Hash, typename KeyEqual,
+          typename Allocator = std::allocator<Slot>>
+class HashIndex {
+    static_assert(std::is_trivially_copyable_v<Slot> && std::is_trivially_destructible_v<Slot>,
+                  "HashIndex slots must be trivially copyable (pointers, iterators)");
+    
+    using AllocTraits = std::allocator_traits<Allocator>;
+    using CtrlAllocator = typename AllocTraits::template rebind_alloc<int8_t>;
+    using SlotAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+    
+    int8_t* ctrl_ = nullptr;
+    Slot* slots_ = nullptr;
+    size_t capacity_ = 0;    // 0 or a power of two >= kGroupWidth
+    size_t size_ = 0;
+    size_t growthLeft_ = 0;  // inserts into empty slots before a rehash
+    KeyOf keyOf_;
+    Hash hash_;
+    KeyEqual equal_;
+    Allocator alloc_;
+    
+    static size_t maxLoad(size_t capacity) { return capacity - capacity / 8; }
+    
+    static size_t capacityFor(size_t n) {
+        size_t capacity = detail::kGroupWidth;
+        while (maxLoad(capacity) < n) capacity *= 2;
+        return capacity;
+    }
+    
+    static int8_t h2(uint64_t hash) { return static_cast<int8_t>(hash & 0x7f); }
+    
+    // Group-aligned probe sequence: g, g+1, g+3, g+6, ... covers every
+    // group of a power-of-two table
+    class Probe {
+    public:
+        Probe(uint64_t hash, size_t groups) : mask_(groups - 1), group_((hash >> 7) & mask_) {}
+        
+        [[nodiscard]] size_t offset() const { return group_ * detail::kGroupWidth; }
+        
+        void next() {
+            ++step_;
+            group_ = (group_ + step_) & mask_;
+        }
+    
+    private:
+        size_t mask_;
+        size_t group_;
+        size_t step_ = 0;
+    };
+    
+    void setCtrl(size_t i, int8_t value) { ctrl_[i] = value; }
+    
+    // First empty or deleted slot on the probe sequence of hash
+    size_t findFree(uint64_t hash) const {
+        for (Probe probe(hash, capacity_ / detail::kGroupWidth);; probe.next()) {
+            auto free = detail::Group(ctrl_ + probe.offset()).matchFree();
+            if (free) return probe.offset() + free.lowest();
+        }
+    }
+    
+    void deallocate() {
+        if (!capacity_) return;
+        CtrlAllocator ctrlAlloc(alloc_);
+        SlotAllocator slotAlloc(alloc_);
+        std::allocator_traits<CtrlAllocator>::deallocate(ctrlAlloc, ctrl_, capacity_);
+        std::allocator_traits<SlotAllocator>::deallocate(slotAlloc, slots_, capacity_);
+        ctrl_ = nullptr;
+        slots_ = nullptr;
+        capacity_ = 0;
+    }
+    
+    // Rebuild into a table of newCapacity slots, dropping tombstones. If
+    // Hash throws, the index is unchanged.
+    void rehash(size_t newCapacity) {
+        CtrlAllocator ctrlAlloc(alloc_);
+        SlotAllocator slotAlloc(alloc_);
+        int8_t* ctrl = std::allocator_traits<CtrlAllocator>::allocate(ctrlAlloc, newCapacity);
+        Slot* slots;
+        try {
+            slots = std::allocator_traits<SlotAllocator>::allocate(slotAlloc, newCapacity);
+        } catch (...) {
+            std::allocator_traits<CtrlAllocator>::deallocate(ctrlAlloc, ctrl, newCapacity);
+            throw;
+        }
+        std::memset(ctrl, static_cast<unsigned char>(detail::kCtrlEmpty), newCapacity);
+        
+        HashIndex rebuilt(alloc_, hash_, equal_);
+        rebuilt.ctrl_ = ctrl;
+        rebuilt.slots_ = slots;
+        rebuilt.capacity_ = newCapacity;
+        for (size_t i = 0; i < capacity_; ++i) {
+            if (ctrl_[i] < 0) continue;
+            uint64_t hash = hashOf(keyOf_(slots_[i]));
+            size_t pos = rebuilt.findFree(hash);
+            rebuilt.setCtrl(pos, h2(hash));
+            ::new (static_cast<void*>(rebuilt.slots_ + pos)) Slot(slots_[i]);
+        }
+        rebuilt.size_ = size_;
+        rebuilt.growthLeft_ = maxLoad(newCapacity) - size_;
+        swapTable(rebuilt);
+    }
+    
+    void swapTable(HashIndex& other) noexcept {
+        std::swap(ctrl_, other.ctrl_);
+        std::swap(slots_, other.slots_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(size_, other.size_);
+        std::swap(growthLeft_, other.growthLeft_);
+    }
+
+public:
+    explicit HashIndex(const Allocator& alloc = Allocator(), const Hash& hash = Hash(),
+                       const KeyEqual& equal = KeyEqual())
+        : hash_(hash), equal_(equal), alloc_(alloc) {}
+    
+    HashIndex(const HashIndex&) = delete;
+    HashIndex& operator=(const HashIndex&) = delete;
+    
+    HashIndex(HashIndex&& other) noexcept
+        : keyOf_(other.keyOf_), hash_(other.hash_), equal_(other.equal_), alloc_(other.alloc_) {
+        swapTable(other);
+    }
+    
+    // Takes other's table when the allocator propagates or compares equal;
+    // otherwise other's slots are copied into memory from this allocator
+    HashIndex& operator=(HashIndex&& other) noexcept(
+        AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value) {
+        if (this == &other) return *this;
+        std::swap(hash_, other.hash_);
+        std::swap(equal_, other.equal_);
+        if constexpr (!AllocTraits::propagate_on_container_move_assignment::value) {
+            if (!(alloc_ == other.alloc_)) {
+                clear();
+                reserve(other.size_);
+                other.forEach([this](const Slot& slot) { insertUnique(slot, hashOf(keyOf_(slot))); });
+                other.clear();
+                return *this;
+            }
+        }
+        deallocate();
+        size_ = growthLeft_ = 0;
+        if constexpr (AllocTraits::propagate_on_container_move_assignment::value) alloc_ = other.alloc_;
+        swapTable(other);
+        return *this;
+    }
+    
+    ~HashIndex() { deallocate(); }
+    
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+    [[nodiscard]] size_t size() const { return size_; }
+    [[nodiscard]] size_t capacity() const { return capacity_; }
+    
+    [[nodiscard]] const Hash& hash_function() const { return hash_; }
+    [[nodiscard]] const KeyEqual& key_eq() const { return equal_; }
+    
+    [[nodiscard]] double load_factor() const {
+        return capacity_ ? static_cast<double>(size_) / static_cast<double>(capacity_) : 0.0;
+    }
+    
+    // Hash of a key as the table uses it; pass it on to find/insert to
+    // hash once per operation
+    template <typename Key>
+    [[nodiscard]] uint64_t hashOf(const Key& key) const {
+        return detail::mixHash(static_cast<uint64_t>(hash_(key)));
+    }
+    
+    // Slot whose key equals key, or nullptr
+    template <typename Key>
+    [[nodiscard]] Slot* find(const Key& key, uint64_t hash) const {
+        if (!capacity_) return nullptr;
+        for (Probe probe(hash, capacity_ / detail::kGroupWidth);; probe.next()) {
+            detail::Group group(ctrl_ + probe.offset());
+            for (auto match = group.match(h2(hash)); match; match.dropLowest()) {
+                size_t i = probe.offset() + match.lowest();
+                if (equal_(keyOf_(slots_[i]), key)) return slots_ + i;
+            }
+            if (group.matchEmpty()) return nullptr;
+        }
+    }
+    
+    template <typename Key>
+    [[nodiscard]] Slot* find(const Key& key) const { return find(key, hashOf(key)); }
+    
+    // Add a slot whose key is not in the index yet; hash = hashOf(its key)
+    void insertUnique(const Slot& slot, uint64_t hash) {
+        if (growthLeft_ == 0) reserve(size_ + 1);
+        size_t pos = findFree(hash);
+        if (ctrl_[pos] == detail::kCtrlEmpty) --growthLeft_;
+        setCtrl(pos, h2(hash));
+        ::new (static_cast<void*>(slots_ + pos)) Slot(slot);
+        ++size_;
+    }
+    
+    // Remove a slot returned by find()
+    void erase(Slot* slot) {
+        size_t i = static_cast<size_t>(slot - slots_);
+        // A group that still has an empty slot has never been full, so no
+        // probe sequence runs past it and the slot can become empty again
+        size_t group = i / detail::kGroupWidth * detail::kGroupWidth;
+        if (detail::Group(ctrl_ + group).matchEmpty()) {
+            setCtrl(i, detail::kCtrlEmpty);
+            ++growthLeft_;
+        } else {
+            setCtrl(i, detail::kCtrlDeleted);
+        }
+        --size_;
+    }
+    
+    // Remove the slot with this key; returns whether there was one
+    template <typename Key>
+    bool erase(const Key& key) {
+        Slot* slot = find(key);
+        if (!slot) return false;
+        erase(slot);
+        return true;
+    }
+    
+    // Room for n slots without rehashing. A full table of tombstones is
+    // rebuilt at its current size rather than grown.
+    void reserve(size_t n) {
+        if (!capacity_) {
+            rehash(capacityFor(n));
+        } else if (n > size_ + growthLeft_) {
+            bool tombstones = n <= maxLoad(capacity_) / 2;
+            rehash(tombstones ? capacity_ : std::max(capacityFor(n), capacity_ * 2));
+        }
+    }
+    
+    // Forget every slot; the capacity is kept
+    void clear() {
+        if (!capacity_) return;
+        std::memset(ctrl_, static_cast<unsigned char>(detail::kCtrlEmpty), capacity_);
+        size_ = 0;
+        growthLeft_ = maxLoad(capacity_);
+    }
+    
+    // Call fn(slot) for every slot, in table order
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (size_t i = 0; i < capacity_; ++i) {
+            if (ctrl_[i] >= 0) fn(slots_[i]);
+        }
+    }
+};
+
+} // namespace dsa
@@ -0,0 +1,247 @@
+#pragma once
+
+/**
+ * @file IndexedList.hpp
+ * @brief Insertion-ordered list of distinct values with O(1) lookup by value
+ * @author Neel Patel
+ * @version 1.0.0
+ *
+ * Features:
+ * - A dsa::List of the elements plus a HashIndex from each value to its
+ *   node, kept in sync by every push, insert, erase, pop and clear
+ * - O(1) average contains, find and erase by value; the list keeps its
+ *   order and O(1) operations at both ends and at an iterator
+ * - Values are distinct: inserting one already present returns the
+ *   existing element, which makes it a de-duplicating queue or LRU order
+ * - splice() reorders elements without touching the index
+ * - Iterators are read-only (changing a value would invalidate its index
+ *   entry) and stay valid until their element is erased
+ * - Allocator-aware (std::allocator, std::pmr, dsa::PoolAllocator)
+ */
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <utility>
+#include "HashIndex.hpp"
+#include "List.hpp"
+
+namespace dsa {
+
+template <typename T, typename Hash = std::hash<T>, typename KeyEqual = std::equal_to<T>,
+          typename Allocator = std::allocator<T>>
+class IndexedList {
+private:
+    using Elements = List<T, Allocator>;
+    using Position = typename Elements::const_iterator;
+    
+    struct ValueOf {
+        const T& operator()(Position pos) const { return *pos; }
+    };
+    
+    using Index = HashIndex<Position, ValueOf, Hash, KeyEqual,
+                            typename std::allocator_traits<Allocator>::template rebind_alloc<Position>>;
+    
+    Elements list_;
+    Index index_;
+    
+    void rebuildIndex() {
+        index_.clear();
+        index_.reserve(list_.size());
+        for (Position pos = list_.cbegin(); pos != list_.cend(); ++pos) {
+            index_.insertUnique(pos, index_.hashOf(*pos));
+        }
+    }
+    
+    // Link value in before pos unless it is already present
+    template <typename V>
+    std::pair<Position, bool> insertUnique(Position pos, V&& value) {
+        uint64_t hash = index_.hashOf(value);
+        if (const Position* found = index_.find(value, hash)) return {*found, false};
+        index_.reserve(index_.size() + 1);  // the index insert below cannot throw
+        Position inserted = list_.insert(pos, std::forward<V>(value));
+        index_.insertUnique(inserted, hash);
+        return {inserted, true};
+    }
+    
+    // Erase the element behind an index slot
+    Position unindex(Position* slot) {
+        Position pos = *slot;
+        index_.erase(slot);
+        return list_.erase(pos);
+    }
+    
+    Position unindex(Position pos) { return unindex(index_.find(*pos)); }
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = size_t;
+    using iterator = Position;
+    using const_iterator = Position;
+    
+    // Constructors & Destructor
+    IndexedList() : IndexedList(Allocator()) {}
+    
+    explicit IndexedList(const Allocator& alloc) : list_(alloc), index_(alloc) {}
+    
+    // Later duplicates in init are dropped
+    IndexedList(std::initializer_list<T> init, const Allocator& alloc = Allocator())
+        : IndexedList(alloc) {
+        index_.reserve(init.size());
+        for (const auto& item : init) push_back(item);
+    }
+    
+    // The copy gets its own index over its own nodes, with other's Hash and KeyEqual
+    IndexedList(const IndexedList& other)
+        : list_(other.list_),
+          index_(list_.get_allocator(), other.index_.hash_function(), other.index_.key_eq()) {
+        rebuildIndex();
+    }
+    
+    // Nodes change owner, so the index entries stay valid
+    IndexedList(IndexedList&& other) noexcept = default;
+    
+    IndexedList& operator=(const IndexedList& other) {
+        if (this != &other) {
+            index_.clear();
+            try {
+                list_ = other.list_;
+                index_ = Index(list_.get_allocator(), other.index_.hash_function(), other.index_.key_eq());
+                rebuildIndex();
+            } catch (...) {
+                clear();
+                throw;
+            }
+        }
+        return *this;
+    }
+    
+    IndexedList& operator=(IndexedList&& other) noexcept(
+        std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+        std::allocator_traits<Allocator>::is_always_equal::value) {
+        if (this != &other) {
+            bool stealsNodes = std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+                               list_.get_allocator() == other.list_.get_allocator();
+            list_ = std::move(other.list_);
+            if (stealsNodes) {
+                // The index follows the list's allocator, so its table moves too
+                index_ = std::move(other.index_);
+            } else {
+                // Moved element-wise into new nodes: index them afresh
+                rebuildIndex();
+                other.index_.clear();
+            }
+        }
+        return *this;
+    }
+    
+    ~IndexedList() = default;
+    
+    [[nodiscard]] allocator_type get_allocator() const { return list_.get_allocator(); }
+    
+    // Iterators (read-only)
+    const_iterator begin() const { return list_.cbegin(); }
+    const_iterator end() const { return list_.cend(); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    
+    // Capacity
+    [[nodiscard]] bool empty() const { return list_.empty(); }
+    [[nodiscard]] size_t size() const { return list_.size(); }
+    
+    // Room for n elements in the index without rehashing
+    void reserve(size_t n) { index_.reserve(n); }
+    
+    // Element access
+    const T& front() const { return list_.front(); }
+    const T& back() const { return list_.back(); }
+    
+    // Lookup, O(1) average
+    [[nodiscard]] bool contains(const T& value) const { return index_.find(value) != nullptr; }
+    
+    // The element equal to value, or end()
+    [[nodiscard]] const_iterator find(const T& value) const {
+        const Position* found = index_.find(value);
+        return found ? *found : end();
+    }
+    
+    // Modifiers: each returns the element equal to value and whether it was
+    // inserted; an existing element stays where it is
+    std::pair<iterator, bool> push_front(const T& value) { return insertUnique(begin(), value); }
+    std::pair<iterator, bool> push_front(T&& value) { return insertUnique(begin(), std::move(value)); }
+    std::pair<iterator, bool> push_back(const T& value) { return insertUnique(end(), value); }
+    std::pair<iterator, bool> push_back(T&& value) { return insertUnique(end(), std::move(value)); }
+    
+    // Insert before pos
+    std::pair<iterator, bool> insert(const_iterator pos, const T& value) { return insertUnique(pos, value); }
+    std::pair<iterator, bool> insert(const_iterator pos, T&& value) {
+        return insertUnique(pos, std::move(value));
+    }
+    
+    void pop_front() {
+        if (empty()) throw std::out_of_range("List is empty");
+        unindex(begin());
+    }
+    
+    void pop_back() {
+        if (empty()) throw std::out_of_range("List is empty");
+        unindex(std::prev(end()));
+    }
+    
+    // Erase the element at pos; returns the one after it
+    iterator erase(const_iterator pos) { return unindex(pos); }
+    
+    iterator erase(const_iterator first, const_iterator last) {
+        while (first != last) first = unindex(first);
+        return last;
+    }
+    
+    // Erase the element equal to value, O(1) average; returns how many (0 or 1)
+    size_t erase(const T& value) {
+        Position* found = index_.find(value);
+        if (!found) return 0;
+        unindex(found);
+        return 1;
+    }
+    
+    // Remove every element; the index keeps its capacity
+    void clear() {
+        index_.clear();
+        list_.clear();
+    }
+    
+    // Move the element at it in front of pos, O(1)
+    void splice(const_iterator pos, const_iterator it) { list_.splice(pos, list_, it); }
+    
+    // Move the element equal to value to the front (or back); false if absent
+    bool move_to_front(const T& value) {
+        const_iterator it = find(value);
+        if (it == end()) return false;
+        splice(begin(), it);
+        return true;
+    }
+    
+    bool move_to_back(const T& value) {
+        const_iterator it = find(value);
+        if (it == end()) return false;
+        splice(end(), it);
+        return true;
+    }
+    
+    void reverse() noexcept { list_.reverse(); }
+    
+    // Utility
+    void print() const { list_.print(); }
+};
+
+namespace pmr {
+    template <typename T, typename Hash = std::hash<T>, typename KeyEqual = std::equal_to<T>>
+    using IndexedList = dsa::IndexedList<T, Hash, KeyEqual, std::pmr::polymorphic_allocator<T>>;
+}
+
+} // namespace dsa
@@ -0,0 +1,335 @@
+#pragma once
+
+/**
+ * @file Instrumentation.hpp
+ * @brief Opt-in operation counters and latency hooks for sorts and containers
+ * @author Neel Patel
+ * @version 1.0.0
+ *
+ * Features:
+ * - Compile-time policies: instrument::None (the default) compiles every
+ *   hook to nothing; instrument::Counting counts into per-thread blocks
+ * - Counters: comparisons, element moves and swaps, recursion depth, node
+ *   allocations/deallocations, lookups and the nodes they visit
+ * - snapshot() sums all threads, so an exporter thread can scrape it
+ * - Latency samples per operation through a user callback, e.g. into a
+ *   LatencyHistogram with log2 buckets
+ *
+ * Sorts are instrumented through their comparator:
+ *
+ *   dsa::sort::quickSort(v, dsa::instrument::counted(std::less<>()));
+ *
+ * and containers through a template parameter:
+ *
+ *   dsa::LinkedList<int, std::allocator<int>, dsa::instrument::Counting> list;
+ *
+ * A custom policy provides the same static members as None.
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dsa {
+namespace instrument {
+
+enum class Counter : unsigned {
+    Comparisons,
+    Moves,          // element move/copy assignments and constructions
+    Swaps,
+    Allocations,    // container nodes
+    Deallocations,
+    Lookups,        // contains / find calls
+    NodesVisited,   // nodes examined by those lookups
+};
+
+inline constexpr size_t kCounterCount = 7;
+
+enum class Operation { Sort, Insert, Erase, Lookup };
+
+inline const char* operationName(Operation op) {
+    switch (op) {
+        case Operation::Sort: return "sort";
+        case Operation::Insert: return "insert";
+        case Operation::Erase: return "erase";
+        case Operation::Lookup: return "lookup";
+    }
+    return "?";
+}
+
+struct Stats {
+    uint64_t comparisons = 0;
+    uint64_t moves = 0;
+    uint64_t swaps = 0;
+    uint64_t allocations = 0;
+    uint64_t deallocations = 0;
+    uint64_t lookups = 0;
+    uint64_t nodesVisited = 0;
+    uint64_t maxDepth = 0;      // deepest recursion of a sort
+    
+    // Average nodes examined per lookup (tree depth or scan length)
+    [[nodiscard]] double visitsPerLookup() const {
+        return lookups ? static_cast<double>(nodesVisited) / static_cast<double>(lookups) : 0.0;
+    }
+};
+
+// Called with the duration of every timed operation
+using LatencyHook = void (*)(Operation op, uint64_t nanoseconds);
+
+// Disabled: every hook is an empty inline function
+struct None {
+    static constexpr bool enabled = false;
+    
+    static void count(Counter, uint64_t = 1) noexcept {}
+    static void enter() noexcept {}
+    static void leave() noexcept {}
+    static bool timing() noexcept { return false; }
+    static void latency(Operation, uint64_t) noexcept {}
+};
+
+// Counts into a block owned by the calling thread: no shared cache lines
+// on the hot path. Blocks are registered so snapshot() can sum them.
+class Counting {
+public:
+    static constexpr bool enabled = true;
+    
+    static void count(Counter c, uint64_t n = 1) noexcept {
+        std::atomic<uint64_t>& v = local().counters[static_cast<size_t>(c)];
+        v.store(v.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+    
+    // Recursion depth of the current thread
+    static void enter() noexcept {
+        Block& b = local();
+        if (++b.depth > b.maxDepth.load(std::memory_order_relaxed)) {
+            b.maxDepth.store(b.depth, std::memory_order_relaxed);
+        }
+    }
+    
+    static void leave() noexcept { --local().depth; }
+    
+    // Totals over every thread, including threads that have exited
+    [[nodiscard]] static Stats snapshot() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        Stats total = r.retired;
+        for (const Block* b : r.live) add(total, *b);
+        return total;
+    }
+    
+    // The calling thread's counters only
+    [[nodiscard]] static Stats threadSnapshot() {
+        Stats s;
+        add(s, local());
+        return s;
+    }
+    
+    // Zero all counters; counts made concurrently with reset() may survive
+    static void reset() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.retired = Stats();
+        for (Block* b : r.live) {
+            for (auto& c : b->counters) c.store(0, std::memory_order_relaxed);
+            b->maxDepth.store(0, std::memory_order_relaxed);
+        }
+    }
+    
+    // Install (or with nullptr, remove) the latency callback. Operations
+    // are timed only while one is installed; it may run on any thread.
+    static void setLatencyHook(LatencyHook hook) noexcept {
+        hook_.store(hook, std::memory_order_release);
+    }
+    
+    static bool timing() noexcept { return hook_.load(std::memory_order_relaxed) != nullptr; }
+    
+    static void latency(Operation op, uint64_t nanoseconds) {
+        if (LatencyHook hook = hook_.load(std::memory_order_acquire)) hook(op, nanoseconds);
+    }
+
+private:
+    // Written only by its thread; atomics so snapshot() can read them
+    struct Block {
+        std::array<std::atomic<uint64_t>, kCounterCount> counters{};
+        std::atomic<uint64_t> maxDepth{0};
+        uint64_t depth = 0;
+    };
+    
+    struct Registry {
+        std::mutex mutex;
+        std::vector<Block*> live;
+        Stats retired;
+    };
+    
+    // Never destroyed: threads may exit after static destructors have run
+    static Registry& registry() {
+        static Registry* r = new Registry();
+        return *r;
+    }
+    
+    struct ThreadBlock {
+        Block block;
+        
+        ThreadBlock() {
+            Registry& r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            r.live.push_back(&block);
+        }
+        
+        ~ThreadBlock() {
+            Registry& r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            add(r.retired, block);
+            r.live.erase(std::find(r.live.begin(), r.live.end(), &block));
+        }
+    };
+    
+    static Block& local() {
+        thread_local ThreadBlock tb;
+        return tb.block;
+    }
+    
+    static void add(Stats& s, const Block& b) {
+        auto get = [&b](Counter c) { return b.counters[static_cast<size_t>(c)].load(std::memory_order_relaxed); };
+        s.comparisons += get(Counter::Comparisons);
+        s.moves += get(Counter::Moves);
+        s.swaps += get(Counter::Swaps);
+        s.allocations += get(Counter::Allocations);
+        s.deallocations += get(Counter::Deallocations);
+        s.lookups += get(Counter::Lookups);
+        s.nodesVisited += get(Counter::NodesVisited);
+        s.maxDepth = std::max(s.maxDepth, b.maxDepth.load(std::memory_order_relaxed));
+    }
+    
+    static inline std::atomic<LatencyHook> hook_{nullptr};
+};
+
+// RAII latency sample for one operation; empty unless the policy is
+// enabled and a hook is installed
+template <typename Policy, bool = Policy::enabled>
+class Timer {
+public:
+    constexpr explicit Timer(Operation) noexcept {}
+};
+
+template <typename Policy>
+class Timer<Policy, true> {
+public:
+    explicit Timer(Operation op) noexcept : op_(op), active_(Policy::timing()) {
+        if (active_) start_ = std::chrono::steady_clock::now();
+    }
+    
+    Timer(const Timer&) = delete;
+    Timer& operator=(const Timer&) = delete;
+    
+    ~Timer() {
+        if (!active_) return;
+        auto elapsed = std::chrono::steady_clock::now() - start_;
+        Policy::latency(op_, static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+
+private:
+    Operation op_;
+    bool active_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+// RAII recursion level
+template <typename Policy>
+struct DepthScope {
+    DepthScope() noexcept { Policy::enter(); }
+    ~DepthScope() { Policy::leave(); }
+    DepthScope(const DepthScope&) = delete;
+    DepthScope& operator=(const DepthScope&) = delete;
+};
+
+// Comparator that counts its calls; the sorts also report their moves,
+// swaps and recursion depth to Policy when given one
+template <typename Compare, typename Policy = Counting>
+struct Counted {
+    Compare comp;
+    
+    template <typename A, typename B>
+    bool operator()(A&& a, B&& b) const {
+        Policy::count(Counter::Comparisons);
+        return comp(std::forward<A>(a), std::forward<B>(b));
+    }
+};
+
+// Counted comparator for an enabled policy, the comparator itself otherwise
+template <typename Policy = Counting, typename Compare>
+auto counted(Compare comp) {
+    if constexpr (Policy::enabled) return Counted<Compare, Policy>{std::move(comp)};
+    else return comp;
+}
+
+// Policy a comparator reports to: None unless it is a Counted
+template <typename Compare>
+struct PolicyOf { using type = None; };
+
+template <typename Compare, typename Policy>
+struct PolicyOf<Counted<Compare, Policy>> { using type = Policy; };
+
+template <typename Compare>
+using PolicyFor = typename PolicyOf<std::decay_t<Compare>>::type;
+
+// Latency histogram with power-of-two buckets (bucket k holds samples in
+// [2^k, 2^(k+1)) ns); lock-free, recordable from any thread
+class LatencyHistogram {
+public:
+    static constexpr size_t kBuckets = 48;
+    
+    void record(uint64_t nanoseconds) noexcept {
+        size_t bucket = 0;
+        while (bucket + 1 < kBuckets && (nanoseconds >> (bucket + 1)) != 0) ++bucket;
+        buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+        total_.fetch_add(nanoseconds, std::memory_order_relaxed);
+    }
+    
+    [[nodiscard]] uint64_t bucket(size_t k) const noexcept {
+        return buckets_[k].load(std::memory_order_relaxed);
+    }
+    
+    [[nodiscard]] uint64_t count() const noexcept {
+        uint64_t n = 0;
+        for (const auto& b : buckets_) n += b.load(std::memory_order_relaxed);
+        return n;
+    }
+    
+    [[nodiscard]] uint64_t totalNanoseconds() const noexcept {
+        return total_.load(std::memory_order_relaxed);
+    }
+    
+    // Upper bound of the bucket holding the q-quantile sample, q in [0, 1]
+    [[nodiscard]] uint64_t quantileUpperBound(double q) const noexcept {
+        uint64_t n = count();
+        if (n == 0) return 0;
+        auto rank = static_cast<uint64_t>(q * static_cast<double>(n - 1));
+        uint64_t seen = 0;
+        for (size_t k = 0; k < kBuckets; ++k) {
+            seen += bucket(k);
+            if (seen > rank) return (uint64_t(2) << k) - 1;
+        }
+        return UINT64_MAX;
+    }
+    
+    void reset() noexcept {
+        for (auto& b : buckets_) b.store(0, std::memory_order_relaxed);
+        total_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, kBuckets> buckets_{};
+    std::atomic<uint64_t> total_{0};
+};
+
+} // namespace instrument
+} // namespace dsa
@@ -11,19 +11,33 @@
  * - Template-based for any data type
  * - Iterator support for range-based for loops
  * - Exception handling
- * - Move semantics
+ * - Move semantics, in-place construction (emplace) and node handles
+ * - In-place stable merge sort, merge, unique and remove_if by relinking nodes
  * - Copy semantics
+ * - Binary save/load for trivially copyable T (see Serialization.hpp)
+ * - Optional instrumentation policy: allocation and lookup counters,
+ *   latency hooks (see Instrumentation.hpp)
+ * - Allocator-aware (std::allocator, std::pmr, dsa::PoolAllocator)
  */
 
+#include <cstdint>
 #include <iostream>
 #include <stdexcept>
 #include <initializer_list>
 #include <functional>
 #include <memory>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+#include <filesystem>
+#include "Instrumentation.hpp"
+#include "NodePool.hpp"
+#include "Serialization.hpp"
 
 namespace dsa {
 
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>,
+          typename Instrument = instrument::None>
 class LinkedList {
 private:
     struct Node {
@@ -32,13 +46,149 @@ private:
         
         explicit Node(const T& value) : data(value), next(nullptr) {}
         explicit Node(T&& value) : data(std::move(value)), next(nullptr) {}
+        
+        template <typename... Args>
+        explicit Node(std::in_place_t, Args&&... args)
+            : data(std::forward<Args>(args)...), next(nullptr) {}
     };
     
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+    
     Node* head_;
     Node* tail_;
     size_t size_;
+    NodeAllocator alloc_;
+    
+    template <typename... Args>
+    Node* createNode(Args&&... args) {
+        Node* node = NodeTraits::allocate(alloc_, 1);
+        try {
+            NodeTraits::construct(alloc_, node, std::forward<Args>(args)...);
+        } catch (...) {
+            NodeTraits::deallocate(alloc_, node, 1);
+            throw;
+        }
+        Instrument::count(instrument::Counter::Allocations);
+        return node;
+    }
+    
+    void destroyNode(Node* node) {
+        NodeTraits::destroy(alloc_, node);
+        NodeTraits::deallocate(alloc_, node, 1);
+        Instrument::count(instrument::Counter::Deallocations);
+    }
+    
+    // First node matching pred; the one linear search behind contains/find_if
+    template <typename Predicate>
+    Node* scan(Predicate pred) const {
+        Instrument::count(instrument::Counter::Lookups);
+        uint64_t visited = 0;
+        Node* found = nullptr;
+        for (Node* curr = head_; curr; curr = curr->next) {
+            ++visited;
+            if (pred(curr->data)) {
+                found = curr;
+                break;
+            }
+        }
+        Instrument::count(instrument::Counter::NodesVisited, visited);
+        return found;
+    }
+    
+    void stealFrom(LinkedList& other) noexcept {
+        head_ = other.head_;
+        tail_ = other.tail_;
+        size_ = other.size_;
+        other.head_ = other.tail_ = nullptr;
+        other.size_ = 0;
+    }
+    
+    // Node linking: every modifier goes through these, so values are
+    // constructed once and never copied between nodes
+    void linkFront(Node* node) {
+        node->next = head_;
+        head_ = node;
+        if (!tail_) tail_ = head_;
+        ++size_;
+    }
+    
+    void linkBack(Node* node) {
+        node->next = nullptr;
+        if (tail_) {
+            tail_->next = node;
+            tail_ = node;
+        } else {
+            head_ = tail_ = node;
+        }
+        ++size_;
+    }
+    
+    // Caller has checked index <= size_
+    void linkAt(size_t index, Node* node) {
+        if (index == 0) { linkFront(node); return; }
+        if (index == size_) { linkBack(node); return; }
+        
+        Node* curr = head_;
+        for (size_t i = 0; i < index - 1; ++i) curr = curr->next;
+        node->next = curr->next;
+        curr->next = node;
+        ++size_;
+    }
+    
+    // Caller has checked index < size_
+    Node* unlinkAt(size_t index) {
+        Node* node;
+        if (index == 0) {
+            node = head_;
+            head_ = head_->next;
+            if (!head_) tail_ = nullptr;
+        } else {
+            Node* curr = head_;
+            for (size_t i = 0; i < index - 1; ++i) curr = curr->next;
+            node = curr->next;
+            curr->next = node->next;
+            if (node == tail_) tail_ = curr;
+        }
+        --size_;
+        node->next = nullptr;
+        return node;
+    }
+    
+    void resetTail() {
+        tail_ = head_;
+        while (tail_ && tail_->next) tail_ = tail_->next;
+    }
+    
+    static Node** chainEnd(Node** link) {
+        while (*link) link = &(*link)->next;
+        return link;
+    }
+    
+    // Stably merge the sorted chains a and b into out (out may be the
+    // variable b was read from). If comp throws, the unmerged remainders
+    // are appended before rethrowing, so out still holds every node.
+    template <typename Compare>
+    static void mergeChains(Node*& out, Node* a, Node* b, Compare& comp) {
+        Node** link = &out;
+        try {
+            while (a && b) {
+                if (comp(b->data, a->data)) { *link = b; b = b->next; }
+                else { *link = a; a = a->next; }
+                link = &(*link)->next;
+            }
+        } catch (...) {
+            *link = a;
+            *chainEnd(link) = b;
+            throw;
+        }
+        *link = a ? a : b;
+    }
 
 public:
+    using allocator_type = Allocator;
+    using node_type = NodeHandle<T, Node, NodeAllocator>;
+    
     // Iterator class for range-based for loops
     class Iterator {
     private:
@@ -76,16 +226,21 @@ public:
     };
     
     // Constructors & Destructor
-    LinkedList() : head_(nullptr), tail_(nullptr), size_(0) {}
+    LinkedList() : LinkedList(Allocator()) {}
+    
+    explicit LinkedList(const Allocator& alloc)
+        : head_(nullptr), tail_(nullptr), size_(0), alloc_(alloc) {}
     
-    LinkedList(std::initializer_list<T> init) : LinkedList() {
+    LinkedList(std::initializer_list<T> init, const Allocator& alloc = Allocator())
+        : LinkedList(alloc) {
         for (const auto& item : init) {
             push_back(item);
         }
     }
     
     // Copy constructor
-    LinkedList(const LinkedList& other) : LinkedList() {
+    LinkedList(const LinkedList& other)
+        : LinkedList(NodeTraits::select_on_container_copy_construction(other.alloc_)) {
         for (Node* curr = other.head_; curr; curr = curr->next) {
             push_back(curr->data);
         }
@@ -93,7 +248,8 @@ public:
     
     // Move constructor
     LinkedList(LinkedList&& other) noexcept 
-        : head_(other.head_), tail_(other.tail_), size_(other.size_) {
+        : head_(other.head_), tail_(other.tail_), size_(other.size_),
+          alloc_(std::move(other.alloc_)) {
         other.head_ = other.tail_ = nullptr;
         other.size_ = 0;
     }
@@ -102,6 +258,9 @@ public:
     LinkedList& operator=(const LinkedList& other) {
         if (this != &other) {
             clear();
+            if constexpr (NodeTraits::propagate_on_container_copy_assignment::value) {
+                alloc_ = other.alloc_;
+            }
             for (Node* curr = other.head_; curr; curr = curr->next) {
                 push_back(curr->data);
             }
@@ -110,20 +269,33 @@ public:
     }
     
     // Move assignment
-    LinkedList& operator=(LinkedList&& other) noexcept {
+    LinkedList& operator=(LinkedList&& other) noexcept(
+        NodeTraits::propagate_on_container_move_assignment::value ||
+        NodeTraits::is_always_equal::value) {
         if (this != &other) {
             clear();
-            head_ = other.head_;
-            tail_ = other.tail_;
-            size_ = other.size_;
-            other.head_ = other.tail_ = nullptr;
-            other.size_ = 0;
+            if constexpr (NodeTraits::propagate_on_container_move_assignment::value) {
+                alloc_ = std::move(other.alloc_);
+                stealFrom(other);
+            } else {
+                if (alloc_ == other.alloc_) {
+                    stealFrom(other);
+                } else {
+                    // Nodes belong to a different allocator: move element-wise
+                    for (Node* curr = other.head_; curr; curr = curr->next) {
+                        push_back(std::move(curr->data));
+                    }
+                    other.clear();
+                }
+            }
         }
         return *this;
     }
     
     ~LinkedList() { clear(); }
     
+    [[nodiscard]] allocator_type get_allocator() const { return allocator_type(alloc_); }
+    
     // Iterators
     Iterator begin() { return Iterator(head_); }
     Iterator end() { return Iterator(nullptr); }
@@ -151,77 +323,96 @@ public:
     }
     
     // Modifiers
-    void push_front(const T& value) {
-        Node* newNode = new Node(value);
-        newNode->next = head_;
-        head_ = newNode;
-        if (!tail_) tail_ = head_;
-        ++size_;
+    template <typename... Args>
+    T& emplace_front(Args&&... args) {
+        instrument::Timer<Instrument> timer(instrument::Operation::Insert);
+        Node* node = createNode(std::in_place, std::forward<Args>(args)...);
+        linkFront(node);
+        return node->data;
     }
     
-    void push_back(const T& value) {
-        Node* newNode = new Node(value);
-        if (tail_) {
-            tail_->next = newNode;
-            tail_ = newNode;
-        } else {
-            head_ = tail_ = newNode;
-        }
-        ++size_;
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        instrument::Timer<Instrument> timer(instrument::Operation::Insert);
+        Node* node = createNode(std::in_place, std::forward<Args>(args)...);
+        linkBack(node);
+        return node->data;
     }
     
+    // Construct the new element in place so that it ends up at `index`
+    template <typename... Args>
+    T& emplace(size_t index, Args&&... args) {
+        if (index > size_) throw std::out_of_range("Index out of bounds");
+        instrument::Timer<Instrument> timer(instrument::Operation::Insert);
+        Node* node = createNode(std::in_place, std::forward<Args>(args)...);
+        linkAt(index, node);
+        return node->data;
+    }
+    
+    void push_front(const T& value) { emplace_front(value); }
+    void push_front(T&& value) { emplace_front(std::move(value)); }
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+    
     void pop_front() {
         if (empty()) throw std::out_of_range("List is empty");
-        Node* temp = head_;
-        head_ = head_->next;
-        delete temp;
-        --size_;
-        if (empty()) tail_ = nullptr;
+        instrument::Timer<Instrument> timer(instrument::Operation::Erase);
+        destroyNode(unlinkAt(0));
     }
     
     void pop_back() {
         if (empty()) throw std::out_of_range("List is empty");
+        instrument::Timer<Instrument> timer(instrument::Operation::Erase);
         if (size_ == 1) {
-            delete head_;
+            destroyNode(head_);
             head_ = tail_ = nullptr;
         } else {
             Node* curr = head_;
             while (curr->next != tail_) curr = curr->next;
-            delete tail_;
+            destroyNode(tail_);
             tail_ = curr;
             tail_->next = nullptr;
         }
         --size_;
     }
     
-    void insert(size_t index, const T& value) {
-        if (index > size_) throw std::out_of_range("Index out of bounds");
-        if (index == 0) { push_front(value); return; }
-        if (index == size_) { push_back(value); return; }
-        
-        Node* curr = head_;
-        for (size_t i = 0; i < index - 1; ++i) curr = curr->next;
-        Node* newNode = new Node(value);
-        newNode->next = curr->next;
-        curr->next = newNode;
-        ++size_;
-    }
+    void insert(size_t index, const T& value) { emplace(index, value); }
+    void insert(size_t index, T&& value) { emplace(index, std::move(value)); }
     
     void erase(size_t index) {
         if (index >= size_) throw std::out_of_range("Index out of bounds");
-        if (index == 0) { pop_front(); return; }
-        
-        Node* curr = head_;
-        for (size_t i = 0; i < index - 1; ++i) curr = curr->next;
-        Node* toDelete = curr->next;
-        curr->next = toDelete->next;
-        if (toDelete == tail_) tail_ = curr;
-        delete toDelete;
-        --size_;
+        instrument::Timer<Instrument> timer(instrument::Operation::Erase);
+        destroyNode(unlinkAt(index));
+    }
+    
+    // Unlink the element at `index` and hand its node to the caller
+    node_type extract(size_t index) {
+        if (index >= size_) throw std::out_of_range("Index out of bounds");
+        Node* node = unlinkAt(index);
+        return detail::NodeHandleAccess::make<node_type>(node, alloc_);
+    }
+    
+    // Link an extracted node in at `index`; the node must come from a list
+    // with an equal allocator (std::invalid_argument otherwise)
+    void insert(size_t index, node_type&& handle) {
+        if (index > size_) throw std::out_of_range("Index out of bounds");
+        if (handle.empty()) throw std::invalid_argument("Node handle is empty");
+        if (!(detail::NodeHandleAccess::allocator(handle) == alloc_)) {
+            throw std::invalid_argument("Node handle uses a different allocator");
+        }
+        linkAt(index, detail::NodeHandleAccess::release(handle));
     }
     
     void clear() {
-        while (!empty()) pop_front();
+        if (detail::tryBulkRelease<Node>(alloc_)) {
+            Instrument::count(instrument::Counter::Deallocations, size_);
+            head_ = tail_ = nullptr;
+            size_ = 0;
+            return;
+        }
+        while (head_) destroyNode(std::exchange(head_, head_->next));
+        tail_ = nullptr;
+        size_ = 0;
     }
     
     // Algorithms
@@ -237,19 +428,140 @@ public:
         head_ = prev;
     }
     
-    [[nodiscard]] bool contains(const T& value) const {
-        for (Node* curr = head_; curr; curr = curr->next) {
-            if (curr->data == value) return true;
+    // Merge sorted other into this sorted list by relinking; stable, O(n + m).
+    // Throws std::invalid_argument if the allocators differ.
+    template <typename Compare = std::less<T>>
+    void merge(LinkedList& other, Compare comp = Compare()) {
+        if (&other == this || other.empty()) return;
+        if (!(alloc_ == other.alloc_)) throw std::invalid_argument("Lists use different allocators");
+        Node* a = head_;
+        Node* tailA = tail_;
+        Node* b = other.head_;
+        Node* tailB = other.tail_;
+        size_ += other.size_;
+        other.head_ = other.tail_ = nullptr;
+        other.size_ = 0;
+        try {
+            mergeChains(head_, a, b, comp);
+        } catch (...) {
+            resetTail();
+            throw;
+        }
+        // Whichever old tail nothing was linked behind is the new tail
+        tail_ = (tailA && !tailA->next) ? tailA : tailB;
+    }
+    
+    template <typename Compare = std::less<T>>
+    void merge(LinkedList&& other, Compare comp = Compare()) { merge(other, comp); }
+    
+    // Stable merge sort by relinking, O(n log n). Nodes are merged
+    // bottom-up through a fixed array of sorted chains, bins[i] holding
+    // 2^i nodes (a binary counter), so the extra space is O(1) and each
+    // merge works on recently touched nodes. If comp throws, every element
+    // is kept in an unspecified order.
+    template <typename Compare = std::less<T>>
+    void sort(Compare comp = Compare()) {
+        if (size_ < 2) return;
+        instrument::Timer<Instrument> timer(instrument::Operation::Sort);
+        auto less = instrument::counted<Instrument>(comp);
+        constexpr size_t kBins = 64;
+        Node* bins[kBins] = {};
+        Node* rest = head_;
+        Node* carry = nullptr;
+        head_ = nullptr;
+        try {
+            while (rest) {
+                carry = rest;
+                rest = rest->next;
+                carry->next = nullptr;
+                size_t i = 0;
+                for (; bins[i]; ++i) {
+                    // Earlier nodes sit in the higher bins: merge them in first
+                    Node* earlier = std::exchange(bins[i], nullptr);
+                    mergeChains(carry, earlier, carry, less);
+                }
+                bins[i] = std::exchange(carry, nullptr);
+            }
+            for (size_t i = 0; i < kBins; ++i) {
+                if (!bins[i]) continue;
+                Node* earlier = std::exchange(bins[i], nullptr);
+                mergeChains(carry, earlier, carry, less);
+            }
+        } catch (...) {
+            // Gather the in-flight chain, the bins and the unvisited rest
+            Node** link = &head_;
+            *link = carry;
+            for (Node* bin : bins) *(link = chainEnd(link)) = bin;
+            *chainEnd(link) = rest;
+            resetTail();
+            throw;
         }
-        return false;
+        head_ = carry;
+        resetTail();
+    }
+    
+    // Remove consecutive duplicates in one pass; returns how many were removed
+    template <typename BinaryPredicate = std::equal_to<T>>
+    size_t unique(BinaryPredicate pred = BinaryPredicate()) {
+        size_t removed = 0;
+        if (!head_) return removed;
+        for (Node* curr = head_; Node* next = curr->next;) {
+            if (pred(curr->data, next->data)) {
+                curr->next = next->next;
+                if (next == tail_) tail_ = curr;
+                destroyNode(next);
+                --size_;
+                ++removed;
+            } else {
+                curr = next;
+            }
+        }
+        return removed;
+    }
+    
+    // Remove every element matching pred in one pass; returns how many
+    template <typename Predicate>
+    size_t remove_if(Predicate pred) {
+        size_t removed = 0;
+        Node* prev = nullptr;
+        for (Node** link = &head_; *link;) {
+            Node* node = *link;
+            if (pred(node->data)) {
+                *link = node->next;
+                if (node == tail_) tail_ = prev;
+                destroyNode(node);
+                --size_;
+                ++removed;
+            } else {
+                prev = node;
+                link = &node->next;
+            }
+        }
+        return removed;
+    }
+    
+    [[nodiscard]] bool contains(const T& value) const {
+        instrument::Timer<Instrument> timer(instrument::Operation::Lookup);
+        return scan([&value](const T& item) { return item == value; }) != nullptr;
     }
     
     template<typename Predicate>
     Node* find_if(Predicate pred) {
-        for (Node* curr = head_; curr; curr = curr->next) {
-            if (pred(curr->data)) return curr;
-        }
-        return nullptr;
+        return scan(std::move(pred));
+    }
+    
+    // Write the elements front to back (io::Layout::Sequence); T trivially copyable
+    void save(const std::filesystem::path& path) const {
+        io::detail::saveElements<T>(path, io::Layout::Sequence, Iterator(head_), Iterator(nullptr), size_);
+    }
+    
+    // Replace the contents with a file written by save(). Throws
+    // std::runtime_error if the file is unreadable or does not match T;
+    // the list is unchanged in that case.
+    void load(const std::filesystem::path& path) {
+        std::vector<T> values = io::detail::loadElements<T>(path, {io::Layout::Sequence});
+        clear();
+        for (const T& value : values) push_back(value);
     }
     
     // Utility
@@ -263,4 +575,9 @@ public:
     }
 };
 
+namespace pmr {
+    template <typename T>
+    using LinkedList = dsa::LinkedList<T, std::pmr::polymorphic_allocator<T>>;
+}
+
 } // namespace dsa
@@ -0,0 +1,464 @@
+#pragma once
+
+/**
+ * @file List.hpp
+ * @brief Doubly linked list with O(1) end operations and splicing
+ * @author Neel Patel
+ * @version 1.0.0
+ *
+ * Features:
+ * - Circular layout around a sentinel: O(1) push/pop at both ends
+ * - Bidirectional iterators that stay valid until their element is erased
+ * - insert / insert_after / erase at an iterator in O(1)
+ * - splice of single elements, ranges and whole lists between lists,
+ *   without copying or allocating; merge of sorted lists by relinking
+ * - Allocator-aware (std::allocator, std::pmr, dsa::PoolAllocator)
+ */
+
+#include <iostream>
+#include <stdexcept>
+#include <initializer_list>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+#include "NodePool.hpp"
+
+namespace dsa {
+
+template <typename T, typename Allocator = std::allocator<T>>
+class List {
+private:
+    struct NodeBase {
+        NodeBase* prev;
+        NodeBase* next;
+    };
+    
+    struct Node : NodeBase {
+        T data;
+        
+        template <typename... Args>
+        explicit Node(Args&&... args) : NodeBase{nullptr, nullptr}, data(std::forward<Args>(args)...) {}
+    };
+    
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+    
+    NodeBase sentinel_; // prev = last element, next = first element
+    size_t size_;
+    NodeAllocator alloc_;
+    
+    template <typename... Args>
+    Node* createNode(Args&&... args) {
+        Node* node = NodeTraits::allocate(alloc_, 1);
+        try {
+            NodeTraits::construct(alloc_, node, std::forward<Args>(args)...);
+        } catch (...) {
+            NodeTraits::deallocate(alloc_, node, 1);
+            throw;
+        }
+        return node;
+    }
+    
+    void destroyNode(NodeBase* node) {
+        Node* n = static_cast<Node*>(node);
+        NodeTraits::destroy(alloc_, n);
+        NodeTraits::deallocate(alloc_, n, 1);
+    }
+    
+    void resetEmpty() noexcept {
+        sentinel_.prev = sentinel_.next = &sentinel_;
+        size_ = 0;
+    }
+    
+    // Link node in front of pos
+    static void linkBefore(NodeBase* pos, NodeBase* node) noexcept {
+        node->prev = pos->prev;
+        node->next = pos;
+        pos->prev->next = node;
+        pos->prev = node;
+    }
+    
+    static void unlink(NodeBase* node) noexcept {
+        node->prev->next = node->next;
+        node->next->prev = node->prev;
+    }
+    
+    // Move [first, last) in front of pos; the ranges must not overlap
+    static void relink(NodeBase* pos, NodeBase* first, NodeBase* last) noexcept {
+        if (first == last || pos == last) return;
+        NodeBase* tail = last->prev;
+        first->prev->next = last;
+        last->prev = first->prev;
+        tail->next = pos;
+        first->prev = pos->prev;
+        pos->prev->next = first;
+        pos->prev = tail;
+    }
+    
+    // Take over other's nodes; *this must be empty
+    void stealFrom(List& other) noexcept {
+        if (other.empty()) return;
+        sentinel_.next = other.sentinel_.next;
+        sentinel_.prev = other.sentinel_.prev;
+        sentinel_.next->prev = sentinel_.prev->next = &sentinel_;
+        size_ = other.size_;
+        other.resetEmpty();
+    }
+    
+    template <typename Other>
+    void requireSameAllocator(const Other& other) const {
+        if constexpr (!NodeTraits::is_always_equal::value) {
+            if (!(alloc_ == other.alloc_)) throw std::invalid_argument("Lists use different allocators");
+        }
+    }
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = size_t;
+    
+    // Bidirectional iterator; Const selects the read-only flavour
+    template <bool Const>
+    class BasicIterator {
+    private:
+        NodeBase* current_;
+        friend class List;
+        
+        explicit BasicIterator(NodeBase* node) : current_(node) {}
+    
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+        
+        BasicIterator() : current_(nullptr) {}
+        
+        // iterator -> const_iterator
+        template <bool C = Const, typename = std::enable_if_t<C>>
+        BasicIterator(const BasicIterator<false>& other) : current_(other.current_) {}
+        
+        reference operator*() const { return static_cast<Node*>(current_)->data; }
+        pointer operator->() const { return &static_cast<Node*>(current_)->data; }
+        
+        BasicIterator& operator++() {
+            current_ = current_->next;
+            return *this;
+        }
+        
+        BasicIterator operator++(int) {
+            BasicIterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+        
+        BasicIterator& operator--() {
+            current_ = current_->prev;
+            return *this;
+        }
+        
+        BasicIterator operator--(int) {
+            BasicIterator tmp = *this;
+            --(*this);
+            return tmp;
+        }
+        
+        friend bool operator==(const BasicIterator& a, const BasicIterator& b) {
+            return a.current_ == b.current_;
+        }
+        
+        friend bool operator!=(const BasicIterator& a, const BasicIterator& b) {
+            return a.current_ != b.current_;
+        }
+    };
+    
+    using iterator = BasicIterator<false>;
+    using const_iterator = BasicIterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    
+    // Constructors & Destructor
+    List() : List(Allocator()) {}
+    
+    explicit List(const Allocator& alloc) : alloc_(alloc) { resetEmpty(); }
+    
+    List(std::initializer_list<T> init, const Allocator& alloc = Allocator()) : List(alloc) {
+        for (const auto& item : init) push_back(item);
+    }
+    
+    List(const List& other)
+        : List(NodeTraits::select_on_container_copy_construction(other.alloc_)) {
+        for (const T& item : other) push_back(item);
+    }
+    
+    List(List&& other) noexcept : alloc_(std::move(other.alloc_)) {
+        resetEmpty();
+        stealFrom(other);
+    }
+    
+    List& operator=(const List& other) {
+        if (this != &other) {
+            clear();
+            if constexpr (NodeTraits::propagate_on_container_copy_assignment::value) {
+                alloc_ = other.alloc_;
+            }
+            for (const T& item : other) push_back(item);
+        }
+        return *this;
+    }
+    
+    List& operator=(List&& other) noexcept(
+        NodeTraits::propagate_on_container_move_assignment::value ||
+        NodeTraits::is_always_equal::value) {
+        if (this != &other) {
+            clear();
+            if constexpr (NodeTraits::propagate_on_container_move_assignment::value) {
+                alloc_ = std::move(other.alloc_);
+                stealFrom(other);
+            } else {
+                if (alloc_ == other.alloc_) {
+                    stealFrom(other);
+                } else {
+                    // Nodes belong to a different allocator: move element-wise
+                    for (T& item : other) push_back(std::move(item));
+                    other.clear();
+                }
+            }
+        }
+        return *this;
+    }
+    
+    ~List() { clear(); }
+    
+    [[nodiscard]] allocator_type get_allocator() const { return allocator_type(alloc_); }
+    
+    // Iterators; end() is the sentinel, so --end() is the last element
+    iterator begin() { return iterator(sentinel_.next); }
+    iterator end() { return iterator(&sentinel_); }
+    const_iterator begin() const { return const_iterator(sentinel_.next); }
+    const_iterator end() const { return const_iterator(const_cast<NodeBase*>(&sentinel_)); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+    
+    // Capacity
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+    [[nodiscard]] size_t size() const { return size_; }
+    
+    // Element access
+    T& front() {
+        if (empty()) throw std::out_of_range("List is empty");
+        return static_cast<Node*>(sentinel_.next)->data;
+    }
+    
+    const T& front() const {
+        if (empty()) throw std::out_of_range("List is empty");
+        return static_cast<const Node*>(sentinel_.next)->data;
+    }
+    
+    T& back() {
+        if (empty()) throw std::out_of_range("List is empty");
+        return static_cast<Node*>(sentinel_.prev)->data;
+    }
+    
+    const T& back() const {
+        if (empty()) throw std::out_of_range("List is empty");
+        return static_cast<const Node*>(sentinel_.prev)->data;
+    }
+    
+    // Modifiers
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args) {
+        Node* node = createNode(std::forward<Args>(args)...);
+        linkBefore(pos.current_, node);
+        ++size_;
+        return iterator(node);
+    }
+    
+    template <typename... Args>
+    T& emplace_front(Args&&... args) { return *emplace(begin(), std::forward<Args>(args)...); }
+    
+    template <typename... Args>
+    T& emplace_back(Args&&... args) { return *emplace(end(), std::forward<Args>(args)...); }
+    
+    void push_front(const T& value) { emplace(begin(), value); }
+    void push_front(T&& value) { emplace(begin(), std::move(value)); }
+    void push_back(const T& value) { emplace(end(), value); }
+    void push_back(T&& value) { emplace(end(), std::move(value)); }
+    
+    void pop_front() {
+        if (empty()) throw std::out_of_range("List is empty");
+        erase(begin());
+    }
+    
+    void pop_back() {
+        if (empty()) throw std::out_of_range("List is empty");
+        erase(const_iterator(sentinel_.prev));
+    }
+    
+    // Insert before pos; returns the new element
+    iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+    
+    // Insert after pos (which must not be end()); returns the new element
+    iterator insert_after(const_iterator pos, const T& value) {
+        return emplace(std::next(pos), value);
+    }
+    
+    iterator insert_after(const_iterator pos, T&& value) {
+        return emplace(std::next(pos), std::move(value));
+    }
+    
+    // Erase the element at pos; returns the one after it
+    iterator erase(const_iterator pos) {
+        NodeBase* node = pos.current_;
+        NodeBase* next = node->next;
+        unlink(node);
+        destroyNode(node);
+        --size_;
+        return iterator(next);
+    }
+    
+    iterator erase(const_iterator first, const_iterator last) {
+        while (first != last) first = erase(first);
+        return iterator(last.current_);
+    }
+    
+    void clear() {
+        if (!detail::tryBulkRelease<Node>(alloc_)) {
+            NodeBase* node = sentinel_.next;
+            while (node != &sentinel_) {
+                NodeBase* next = node->next;
+                destroyNode(node);
+                node = next;
+            }
+        }
+        resetEmpty();
+    }
+    
+    // Splicing: nodes change lists without being copied. Both lists must
+    // use equal allocators (std::invalid_argument otherwise).
+    
+    // All of other, before pos; O(1)
+    void splice(const_iterator pos, List& other) {
+        if (&other == this || other.empty()) return;
+        requireSameAllocator(other);
+        relink(pos.current_, other.sentinel_.next, &other.sentinel_);
+        size_ += other.size_;
+        other.size_ = 0;
+    }
+    
+    void splice(const_iterator pos, List&& other) { splice(pos, other); }
+    
+    // The element at it, before pos; O(1). other may be *this (e.g. move to front).
+    void splice(const_iterator pos, List& other, const_iterator it) {
+        if (pos == it || pos.current_ == it.current_->next) return;
+        if (&other != this) requireSameAllocator(other);
+        relink(pos.current_, it.current_, it.current_->next);
+        if (&other != this) {
+            ++size_;
+            --other.size_;
+        }
+    }
+    
+    // [first, last) of other, before pos (which must lie outside the range).
+    // O(1) within one list or when count = distance(first, last) is given,
+    // O(count) otherwise to keep size() exact.
+    void splice(const_iterator pos, List& other, const_iterator first, const_iterator last,
+                size_t count) {
+        if (&other != this) {
+            requireSameAllocator(other);
+            size_ += count;
+            other.size_ -= count;
+        }
+        relink(pos.current_, first.current_, last.current_);
+    }
+    
+    void splice(const_iterator pos, List& other, const_iterator first, const_iterator last) {
+        size_t count = &other == this ? 0 : static_cast<size_t>(std::distance(first, last));
+        splice(pos, other, first, last, count);
+    }
+    
+    // Merge sorted other into this sorted list by relinking; stable, O(n + m).
+    // Sizes move with each run, so both stay exact if comp throws.
+    template <typename Compare = std::less<T>>
+    void merge(List& other, Compare comp = Compare()) {
+        if (&other == this || other.empty()) return;
+        requireSameAllocator(other);
+        NodeBase* pos = sentinel_.next;
+        NodeBase* src = other.sentinel_.next;
+        while (src != &other.sentinel_) {
+            if (pos == &sentinel_) {
+                relink(pos, src, &other.sentinel_);
+                size_ += std::exchange(other.size_, 0);
+                break;
+            }
+            if (comp(static_cast<Node*>(src)->data, static_cast<Node*>(pos)->data)) {
+                // Move the whole run of other that belongs before pos at once
+                NodeBase* runEnd = src->next;
+                size_t count = 1;
+                while (runEnd != &other.sentinel_ &&
+                       comp(static_cast<Node*>(runEnd)->data, static_cast<Node*>(pos)->data)) {
+                    runEnd = runEnd->next;
+                    ++count;
+                }
+                relink(pos, src, runEnd);
+                size_ += count;
+                other.size_ -= count;
+                src = runEnd;
+            } else {
+                pos = pos->next;
+            }
+        }
+    }
+    
+    template <typename Compare = std::less<T>>
+    void merge(List&& other, Compare comp = Compare()) { merge(other, comp); }
+    
+    // Algorithms
+    void reverse() noexcept {
+        NodeBase* node = &sentinel_;
+        do {
+            std::swap(node->prev, node->next);
+            node = node->prev; // the old next
+        } while (node != &sentinel_);
+    }
+    
+    [[nodiscard]] bool contains(const T& value) const {
+        for (const T& item : *this) {
+            if (item == value) return true;
+        }
+        return false;
+    }
+    
+    template <typename Predicate>
+    iterator find_if(Predicate pred) {
+        for (iterator it = begin(); it != end(); ++it) {
+            if (pred(*it)) return it;
+        }
+        return end();
+    }
+    
+    // Utility
+    void print() const {
+        std::cout << "[";
+        for (const_iterator it = begin(); it != end(); ++it) {
+            if (it != begin()) std::cout << " <-> ";
+            std::cout << *it;
+        }
+        std::cout << "]" << std::endl;
+    }
+};
+
+namespace pmr {
+    template <typename T>
+    using List = dsa::List<T, std::pmr::polymorphic_allocator<T>>;
+}
+
+} // namespace dsa
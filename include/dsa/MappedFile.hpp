@@ -0,0 +1,90 @@
+#pragma once
+
+/**
+ * @file MappedFile.hpp
+ * @brief RAII memory mapping of whole files (POSIX)
+ * @author Neel Patel
+ * @version 1.0.0
+ *
+ * Defines DSA_HAS_MMAP where mmap is available; callers fall back to
+ * stream I/O elsewhere. Used by ExternalSort and the mapped StaticSearchTree.
+ */
+
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define DSA_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace dsa {
+
+#if defined(DSA_HAS_MMAP)
+// RAII read-only or read-write mapping of a whole file
+class MappedFile {
+public:
+    // Update maps an existing file read-write, keeping its contents
+    enum class Mode { Read, ReadWrite, Update };
+    
+    // ReadWrite creates or truncates the file to `size` bytes
+    MappedFile(const std::filesystem::path& path, Mode mode, size_t size = 0) {
+        bool write = mode != Mode::Read;
+        int flags = mode == Mode::ReadWrite ? (O_RDWR | O_CREAT | O_TRUNC) : write ? O_RDWR : O_RDONLY;
+        fd_ = ::open(path.c_str(), flags, 0644);
+        if (fd_ < 0) fail("open " + path.string());
+        if (mode == Mode::ReadWrite) {
+            if (::ftruncate(fd_, static_cast<off_t>(size)) != 0) fail("resize " + path.string());
+            size_ = size;
+        } else {
+            struct stat st;
+            if (::fstat(fd_, &st) != 0) fail("stat " + path.string());
+            size_ = static_cast<size_t>(st.st_size);
+        }
+        if (size_ == 0) return;
+        void* p = ::mmap(nullptr, size_, write ? (PROT_READ | PROT_WRITE) : PROT_READ,
+                         MAP_SHARED, fd_, 0);
+        if (p == MAP_FAILED) fail("mmap " + path.string());
+        data_ = static_cast<std::byte*>(p);
+    }
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    ~MappedFile() { close(); }
+    
+    // Hint that the mapping will be read front to back once
+    void adviseSequential() const {
+        if (data_) ::madvise(data_, size_, MADV_SEQUENTIAL);
+    }
+    
+    [[nodiscard]] std::byte* data() const { return data_; }
+    [[nodiscard]] size_t size() const { return size_; }
+
+private:
+    [[noreturn]] void fail(const std::string& what) {
+        int err = errno;
+        close();
+        throw std::system_error(err, std::generic_category(), what);
+    }
+    
+    void close() noexcept {
+        if (data_) ::munmap(data_, size_);
+        if (fd_ >= 0) ::close(fd_);
+        data_ = nullptr;
+        fd_ = -1;
+    }
+    
+    int fd_ = -1;
+    std::byte* data_ = nullptr;
+    size_t size_ = 0;
+};
+#endif
+
+} // namespace dsa
@@ -0,0 +1,337 @@
+#pragma once
+
+/**
+ * @file NodePool.hpp
+ * @brief Slab/arena memory pool and allocator for node-based containers
+ * @author Neel Patel
+ * @version 1.0.0
+ *
+ * Features:
+ * - Bump allocation out of large blocks, so consecutive nodes are adjacent
+ * - Per-size free lists for O(1) reuse of released nodes; sizes above the
+ *   pooled classes and over-aligned requests get a free list per
+ *   (size, alignment) pair
+ * - O(blocks) release() of the whole arena at once
+ * - std::pmr::memory_resource interface (usable with polymorphic_allocator)
+ * - PoolAllocator<T>: standard allocator backed by a shared NodePool
+ * - NodeHandle: a node extracted from a container, reinsertable without reallocating
+ *
+ * A NodePool is not thread-safe; give each thread its own pool.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dsa {
+
+class NodePool : public std::pmr::memory_resource {
+public:
+    static constexpr size_t kDefaultBlockSize = 4096;
+    static constexpr size_t kMaxBlockSize = 1 << 20;
+    
+    explicit NodePool(size_t initialBlockSize = kDefaultBlockSize,
+                      std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : upstream_(upstream), nextBlockSize_(initialBlockSize < 64 ? 64 : initialBlockSize) {}
+    
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+    
+    ~NodePool() override { release(); }
+    
+    // Make sure at least `bytes` can be handed out from a single block
+    void reserve(size_t bytes) {
+        if (static_cast<size_t>(end_ - cursor_) < bytes) grow(bytes);
+    }
+    
+    // Return every block to upstream; all outstanding allocations become invalid
+    void release() noexcept {
+        while (blocks_) {
+            Block* next = blocks_->next;
+            upstream_->deallocate(blocks_, blocks_->size, alignof(std::max_align_t));
+            blocks_ = next;
+        }
+        for (auto& list : free_) list = nullptr;
+        for (auto& list : large_) list.head = nullptr;
+        cursor_ = end_ = nullptr;
+        bytesInUse_ = 0;
+    }
+    
+    // Bytes one pooled allocation of this size actually occupies in a block
+    [[nodiscard]] static constexpr size_t slotSize(size_t bytes, size_t alignment) noexcept {
+        size_t cls = sizeClass(bytes, alignment);
+        return cls < kClasses ? (cls + 1) * kGranule : largeSize(bytes) + alignment;
+    }
+    
+    [[nodiscard]] size_t bytesInUse() const noexcept { return bytesInUse_; }
+    [[nodiscard]] std::pmr::memory_resource* upstream() const noexcept { return upstream_; }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        size_t cls = sizeClass(bytes, alignment);
+        // The list is created here, so that do_deallocate never allocates
+        FreeSlot*& list = cls < kClasses ? free_[cls] : largeList(bytes, alignment);
+        bytesInUse_ += bytes;
+        if (list) {
+            FreeSlot* slot = list;
+            list = slot->next;
+            return slot;
+        }
+        size_t size = cls < kClasses ? (cls + 1) * kGranule : largeSize(bytes);
+        return bump(size, alignment);
+    }
+    
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        bytesInUse_ -= bytes;
+        size_t cls = sizeClass(bytes, alignment);
+        FreeSlot*& list = cls < kClasses ? free_[cls] : largeList(bytes, alignment);
+        auto* slot = static_cast<FreeSlot*>(p);
+        slot->next = list;
+        list = slot;
+    }
+    
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+private:
+    struct FreeSlot { FreeSlot* next; };
+    
+    // Free list for one size and alignment outside the pooled classes
+    struct LargeList {
+        size_t bytes;
+        size_t alignment;
+        FreeSlot* head;
+    };
+    struct alignas(std::max_align_t) Block {
+        Block* next;
+        size_t size;
+    };
+    
+    static constexpr size_t kGranule = alignof(std::max_align_t);
+    static constexpr size_t kClasses = 16; // pooled slots up to 16 * kGranule bytes
+    
+    static constexpr size_t sizeClass(size_t bytes, size_t alignment) {
+        if (alignment > kGranule || bytes == 0) return kClasses;
+        return (bytes - 1) / kGranule;
+    }
+    
+    static constexpr size_t largeSize(size_t bytes) {
+        return bytes < sizeof(FreeSlot) ? sizeof(FreeSlot) : bytes;
+    }
+    
+    // Containers ask for a handful of node sizes, so a linear scan is enough
+    FreeSlot*& largeList(size_t bytes, size_t alignment) {
+        for (LargeList& list : large_) {
+            if (list.bytes == bytes && list.alignment == alignment) return list.head;
+        }
+        large_.push_back({bytes, alignment, nullptr});
+        return large_.back().head;
+    }
+    
+    void* bump(size_t size, size_t alignment) {
+        auto aligned = [&] {
+            auto addr = reinterpret_cast<uintptr_t>(cursor_);
+            return reinterpret_cast<std::byte*>((addr + alignment - 1) & ~(alignment - 1));
+        };
+        std::byte* p = cursor_ ? aligned() : nullptr;
+        if (!p || p + size > end_) {
+            grow(size + alignment);
+            p = aligned();
+        }
+        cursor_ = p + size;
+        return p;
+    }
+    
+    void grow(size_t minBytes) {
+        size_t size = nextBlockSize_;
+        while (size < minBytes + sizeof(Block)) size *= 2;
+        auto* block = static_cast<Block*>(upstream_->allocate(size, alignof(std::max_align_t)));
+        block->next = blocks_;
+        block->size = size;
+        blocks_ = block;
+        cursor_ = reinterpret_cast<std::byte*>(block + 1);
+        end_ = reinterpret_cast<std::byte*>(block) + size;
+        if (nextBlockSize_ < kMaxBlockSize) nextBlockSize_ *= 2;
+    }
+    
+    std::pmr::memory_resource* upstream_;
+    size_t nextBlockSize_;
+    Block* blocks_ = nullptr;
+    std::byte* cursor_ = nullptr;
+    std::byte* end_ = nullptr;
+    FreeSlot* free_[kClasses] = {};
+    std::vector<LargeList> large_;
+    size_t bytesInUse_ = 0;
+};
+
+// Standard allocator over a shared NodePool. A default-constructed allocator
+// owns a fresh pool; copies and rebinds share it. Container copies get a new
+// pool so that releasing one container never frees another's nodes.
+template <typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    
+    PoolAllocator() : pool_(std::make_shared<NodePool>()) {}
+    explicit PoolAllocator(std::shared_ptr<NodePool> pool) : pool_(std::move(pool)) {}
+    
+    // Copies (and moves, which must leave the source usable) share the pool
+    PoolAllocator(const PoolAllocator&) noexcept = default;
+    PoolAllocator& operator=(const PoolAllocator&) noexcept = default;
+    
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept : pool_(other.pool_) {}
+    
+    [[nodiscard]] T* allocate(size_t n) {
+        return static_cast<T*>(pool_->allocate(n * sizeof(T), alignof(T)));
+    }
+    
+    void deallocate(T* p, size_t n) noexcept {
+        pool_->deallocate(p, n * sizeof(T), alignof(T));
+    }
+    
+    PoolAllocator select_on_container_copy_construction() const { return PoolAllocator(); }
+    
+    [[nodiscard]] NodePool& pool() const noexcept { return *pool_; }
+    
+    // True when no other allocator shares the pool, so it may be released wholesale
+    [[nodiscard]] bool unique() const noexcept { return pool_.use_count() == 1; }
+    void release() noexcept { pool_->release(); }
+    
+    template <typename U>
+    friend bool operator==(const PoolAllocator& a, const PoolAllocator<U>& b) noexcept {
+        return a.pool_ == b.pool_;
+    }
+    
+    template <typename U>
+    friend bool operator!=(const PoolAllocator& a, const PoolAllocator<U>& b) noexcept {
+        return !(a == b);
+    }
+
+private:
+    template <typename U> friend class PoolAllocator;
+    std::shared_ptr<NodePool> pool_;
+};
+
+namespace detail {
+    struct NodeHandleAccess;
+}
+
+// Owns one node taken out of a container by extract(). insert() links it
+// into a container with an equal allocator without reallocating or copying
+// the value; a handle that is never reinserted destroys its node.
+template <typename T, typename Node, typename NodeAllocator>
+class NodeHandle {
+public:
+    using value_type = T;
+    
+    NodeHandle() = default;
+    
+    NodeHandle(NodeHandle&& other) noexcept
+        : node_(std::exchange(other.node_, nullptr)), alloc_(std::move(other.alloc_)) {
+        other.alloc_.reset();
+    }
+    
+    NodeHandle& operator=(NodeHandle&& other) noexcept {
+        if (this != &other) {
+            reset();
+            node_ = std::exchange(other.node_, nullptr);
+            alloc_ = std::move(other.alloc_);
+            other.alloc_.reset();
+        }
+        return *this;
+    }
+    
+    ~NodeHandle() { reset(); }
+    
+    [[nodiscard]] bool empty() const noexcept { return node_ == nullptr; }
+    explicit operator bool() const noexcept { return node_ != nullptr; }
+    
+    // The value may be changed freely before the node is reinserted
+    T& value() const { return node_->data; }
+
+private:
+    using Traits = std::allocator_traits<NodeAllocator>;
+    friend struct detail::NodeHandleAccess;
+    
+    Node* node_ = nullptr;
+    std::optional<NodeAllocator> alloc_; // engaged exactly when node_ is set
+    
+    NodeHandle(Node* node, const NodeAllocator& alloc) : node_(node), alloc_(alloc) {}
+    
+    void reset() noexcept {
+        if (node_) {
+            Traits::destroy(*alloc_, node_);
+            Traits::deallocate(*alloc_, node_, 1);
+            node_ = nullptr;
+        }
+        alloc_.reset();
+    }
+};
+
+namespace detail {
+    // How containers create handles and take their nodes back
+    struct NodeHandleAccess {
+        template <typename Handle, typename Node, typename NodeAllocator>
+        static Handle make(Node* node, const NodeAllocator& alloc) { return Handle(node, alloc); }
+        
+        template <typename Handle>
+        static const auto& allocator(const Handle& handle) { return *handle.alloc_; }
+        
+        template <typename Handle>
+        static auto* release(Handle& handle) {
+            handle.alloc_.reset();
+            return std::exchange(handle.node_, nullptr);
+        }
+    };
+    
+    // Allocators whose whole arena can be dropped at once (see PoolAllocator)
+    template <typename Alloc, typename = void>
+    struct supports_bulk_release : std::false_type {};
+    
+    template <typename Alloc>
+    struct supports_bulk_release<Alloc, std::void_t<
+        decltype(std::declval<Alloc&>().release()),
+        decltype(std::declval<const Alloc&>().unique())>> : std::true_type {};
+    
+    // Release every node of a container in O(1) when nothing needs destroying
+    template <typename Node, typename Alloc>
+    bool tryBulkRelease(Alloc& alloc) {
+        if constexpr (supports_bulk_release<Alloc>::value &&
+                      std::is_trivially_destructible_v<Node>) {
+            if (alloc.unique()) {
+                alloc.release();
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    // Allocators backed by a NodePool that can be pre-sized
+    template <typename Alloc, typename = void>
+    struct supports_reserve : std::false_type {};
+    
+    template <typename Alloc>
+    struct supports_reserve<Alloc, std::void_t<
+        decltype(std::declval<const Alloc&>().pool().reserve(size_t()))>> : std::true_type {};
+    
+    // Make room for n nodes in one block, so a bulk build costs a single
+    // upstream allocation and lays the nodes out contiguously
+    template <typename Node, typename Alloc>
+    void tryReserve(Alloc& alloc, size_t n) {
+        if constexpr (supports_reserve<Alloc>::value) {
+            alloc.pool().reserve(n * NodePool::slotSize(sizeof(Node), alignof(Node)));
+        }
+    }
+}
+
+} // namespace dsa
@@ -0,0 +1,215 @@
+#pragma once
+
+/**
+ * @file ParallelSort.hpp
+ * @brief Multithreaded merge sort and quick sort with execution policies
+ * @author Neel Patel
+ * @version 1.0.0
+ *
+ * Usage: dsa::sort::mergeSort(dsa::execution::par, arr);
+ *        dsa::sort::quickSort(dsa::execution::par.grain(1 << 16), first, last);
+ *
+ * - mergeSort(par, ...) is stable and produces exactly the sequential result;
+ *   both recursive halves and the merges themselves run in parallel
+ * - quickSort(par, ...) forks both sides of every partition of the
+ *   introsort engine
+ * - Ranges shorter than the policy's grain size are sorted sequentially
+ * - Work runs on dsa::ThreadPool::global() unless the policy names a pool
+ */
+
+#include "Sorting.hpp"
+#include "ThreadPool.hpp"
+
+namespace dsa {
+namespace sort {
+
+namespace detail {
+    // Stable merge of [a, aEnd) and [b, bEnd) move-constructed into raw `out`
+    template <typename RandomIt, typename T, typename Compare>
+    void mergeInto(RandomIt a, RandomIt aEnd, RandomIt b, RandomIt bEnd, T* out, Compare comp) {
+        if constexpr (isBranchless<T, Compare>) {
+            while (a != aEnd && b != bEnd) {
+                bool takeB = comp(*b, *a);
+                ::new (static_cast<void*>(out++)) T(takeB ? *b : *a);
+                b += takeB;
+                a += !takeB;
+            }
+        } else {
+            while (a != aEnd && b != bEnd) {
+                if (comp(*b, *a)) ::new (static_cast<void*>(out++)) T(std::move(*b++));
+                else ::new (static_cast<void*>(out++)) T(std::move(*a++));
+            }
+        }
+        out = std::uninitialized_move(a, aEnd, out);
+        std::uninitialized_move(b, bEnd, out);
+    }
+    
+    // Split the larger run at its midpoint, binary-search the matching split
+    // in the other run, and merge the two halves independently. Ties keep
+    // left-run elements first, so the result is stable.
+    template <typename RandomIt, typename T, typename Compare>
+    void parallelMergeInto(RandomIt a, RandomIt aEnd, RandomIt b, RandomIt bEnd, T* out,
+                           Compare comp, size_t grain, TaskGroup& group) {
+        while (static_cast<size_t>((aEnd - a) + (bEnd - b)) > grain) {
+            RandomIt aMid, bMid;
+            if (aEnd - a >= bEnd - b) {
+                aMid = a + (aEnd - a) / 2;
+                bMid = std::lower_bound(b, bEnd, *aMid, comp);
+            } else {
+                bMid = b + (bEnd - b) / 2;
+                aMid = std::upper_bound(a, aEnd, *bMid, comp);
+            }
+            T* outMid = out + (aMid - a) + (bMid - b);
+            group.run([=, &group] {
+                parallelMergeInto(aMid, aEnd, bMid, bEnd, outMid, comp, grain, group);
+            });
+            aEnd = aMid;
+            bEnd = bMid;
+        }
+        mergeInto(a, aEnd, b, bEnd, out, comp);
+    }
+    
+    // `buffer` has room for last - first elements and mirrors the range
+    template <typename RandomIt, typename T, typename Compare>
+    void parallelMergeSort(RandomIt first, RandomIt last, T* buffer, Compare comp,
+                           size_t grain, ThreadPool& pool) {
+        std::ptrdiff_t n = last - first;
+        if (static_cast<size_t>(n) <= grain) {
+            detail::mergeSort(first, last, buffer, comp);
+            return;
+        }
+        
+        RandomIt mid = first + n / 2;
+        {
+            TaskGroup group(pool);
+            group.run([=, &pool] { parallelMergeSort(first, mid, buffer, comp, grain, pool); });
+            parallelMergeSort(mid, last, buffer + n / 2, comp, grain, pool);
+            group.wait();
+        }
+        if (!comp(*mid, *(mid - 1))) return;
+        
+        {
+            TaskGroup group(pool);
+            parallelMergeInto(first, mid, mid, last, buffer, comp, grain, group);
+            group.wait();
+        }
+        parallelFor(pool, 0, static_cast<size_t>(n), grain, [=](size_t lo, size_t hi) {
+            std::move(buffer + lo, buffer + hi, first + lo);
+            std::destroy(buffer + lo, buffer + hi);
+        });
+    }
+    
+    template <typename RandomIt, typename Compare>
+    void parallelIntroSort(RandomIt first, RandomIt last, Compare comp, int badAllowed,
+                           bool leftmost, size_t grain, ThreadPool& pool) {
+        TaskGroup group(pool);
+        while (true) {
+            std::ptrdiff_t size = last - first;
+            if (static_cast<size_t>(size) <= grain || size <= kNintherThreshold) {
+                introSortLoop(first, last, comp, badAllowed, leftmost);
+                break;
+            }
+            
+            std::ptrdiff_t half = size / 2;
+            sort3(first, first + half, last - 1, comp);
+            sort3(first + 1, first + (half - 1), last - 2, comp);
+            sort3(first + 2, first + (half + 1), last - 3, comp);
+            sort3(first + (half - 1), first + half, first + (half + 1), comp);
+            std::iter_swap(first, first + half);
+            note<Compare>(instrument::Counter::Swaps);
+            
+            if (!leftmost && !comp(*(first - 1), *first)) {
+                first = partitionLeft(first, last, comp) + 1;
+                continue;
+            }
+            
+            RandomIt pivotPos = partitionRight(first, last, comp).first;
+            std::ptrdiff_t leftSize = pivotPos - first;
+            std::ptrdiff_t rightSize = last - (pivotPos + 1);
+            if (leftSize < size / 8 || rightSize < size / 8) {
+                if (--badAllowed == 0) {
+                    detail::heapSort(first, last, comp);
+                    break;
+                }
+                breakPatterns<Compare>(first, pivotPos);
+                breakPatterns<Compare>(pivotPos + 1, last);
+            }
+            
+            // Fork the left side, keep working on the right
+            group.run([=, &pool] {
+                parallelIntroSort(first, pivotPos, comp, badAllowed, leftmost, grain, pool);
+            });
+            first = pivotPos + 1;
+            leftmost = false;
+        }
+        group.wait();
+    }
+}
+
+// Sequenced policy: identical to the plain overloads
+template <typename RandomIt, typename Compare = std::less<detail::IterValue<RandomIt>>>
+void mergeSort(const execution::sequenced_policy&, RandomIt first, RandomIt last,
+               Compare comp = Compare()) {
+    mergeSort(first, last, comp);
+}
+
+template <typename RandomIt, typename Compare = std::less<detail::IterValue<RandomIt>>>
+void quickSort(const execution::sequenced_policy&, RandomIt first, RandomIt last,
+               Compare comp = Compare()) {
+    quickSort(first, last, comp);
+}
+
+// Parallel Merge Sort - O(n log n) work, stable; needs an n-element buffer
+template <typename RandomIt, typename Compare = std::less<detail::IterValue<RandomIt>>>
+void mergeSort(const execution::parallel_policy& policy, RandomIt first, RandomIt last,
+               Compare comp = Compare()) {
+    detail::SortTimer<Compare> timer(instrument::Operation::Sort);
+    std::ptrdiff_t n = last - first;
+    if (n < 2) return;
+    MergeBuffer<detail::IterValue<RandomIt>> buffer(static_cast<size_t>(n));
+    detail::parallelMergeSort(first, last, buffer.data(), comp,
+                              std::max<size_t>(policy.grainSize, 2), policy.pool());
+}
+
+// Parallel Quick Sort - O(n log n), in place, not stable
+template <typename RandomIt, typename Compare = std::less<detail::IterValue<RandomIt>>>
+void quickSort(const execution::parallel_policy& policy, RandomIt first, RandomIt last,
+               Compare comp = Compare()) {
+    detail::SortTimer<Compare> timer(instrument::Operation::Sort);
+    std::ptrdiff_t n = last - first;
+    if (n < 2) return;
+    int log2n = 0;
+    while (n >>= 1) ++log2n;
+    detail::parallelIntroSort(first, last, comp, log2n, true,
+                              policy.grainSize, policy.pool());
+}
+
+// Vector and range forms for both policies
+template <typename Policy, typename T, typename Compare = std::less<T>>
+auto mergeSort(const Policy& policy, std::vector<T>& arr, Compare comp = Compare())
+    -> decltype(mergeSort(policy, arr.begin(), arr.end(), comp)) {
+    mergeSort(policy, arr.begin(), arr.end(), comp);
+}
+
+template <typename Policy, typename Range, detail::EnableIfRange<Range> = 0,
+          typename Compare = std::less<detail::RangeValue<Range>>>
+auto mergeSort(const Policy& policy, Range&& range, Compare comp = Compare())
+    -> decltype(mergeSort(policy, std::begin(range), std::end(range), comp)) {
+    mergeSort(policy, std::begin(range), std::end(range), comp);
+}
+
+template <typename Policy, typename T, typename Compare = std::less<T>>
+auto quickSort(const Policy& policy, std::vector<T>& arr, Compare comp = Compare())
+    -> decltype(quickSort(policy, arr.begin(), arr.end(), comp)) {
+    quickSort(policy, arr.begin(), arr.end(), comp);
+}
+
+template <typename Policy, typename Range, detail::EnableIfRange<Range> = 0,
+          typename Compare = std::less<detail::RangeValue<Range>>>
+auto quickSort(const Policy& policy, Range&& range, Compare comp = Compare())
+    -> decltype(quickSort(policy, std::begin(range), std::end(range), comp)) {
+    quickSort(policy, std::begin(range), std::end(range), comp);
+}
+
+} // namespace sort
+} // namespace dsa
@@ -0,0 +1,365 @@
+#pragma once
+
+/**
+ * @file PersistentSearchTree.hpp
+ * @brief Persistent AVL set: O(1) snapshots, copy-on-write updates
+ * @author Neel Patel
+ * @version 1.0.0
+ *
+ * Features:
+ * - snapshot() (or a plain copy) is O(1): versions share structure
+ * - An update copies only the O(log n) nodes on its path that another
+ *   version still shares; nodes this version owns alone are changed in place,
+ *   so a tree with no live snapshots updates without copying at all
+ * - Nodes are reference counted (atomically), so snapshots can be read and
+ *   dropped on other threads while the writer keeps mutating its version
+ * - O(n) construction from sorted input
+ *
+ * Each version is an ordinary value: concurrent reads of one version are
+ * safe, but writing a version (or taking its snapshot) needs exclusive access.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace dsa {
+
+template <typename T>
+class PersistentSearchTree {
+private:
+    struct Node {
+        T key;
+        Node* left = nullptr;
+        Node* right = nullptr;
+        int height = 1;
+        std::atomic<uint32_t> refs{1}; // one per link: a root or a parent
+        
+        explicit Node(const T& k) : key(k) {}
+        
+        // Private copy of `from` for a writer; the children become shared
+        Node(const Node& from) : key(from.key), left(from.left), right(from.right), height(from.height) {
+            retain(left);
+            retain(right);
+        }
+    };
+    
+    Node* root_ = nullptr;
+    size_t size_ = 0;
+    
+    static void retain(Node* node) {
+        if (node) node->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    // Drop one reference; frees the nodes no version reaches any more.
+    // Recursion only follows nodes freed here, so depth is O(log n).
+    static void release(Node* node) {
+        while (node && node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            release(node->left);
+            Node* right = node->right;
+            delete node;
+            node = right;
+        }
+    }
+    
+    // Make the node at link writable by this version: reuse it if no other
+    // version references it, otherwise swap in a private copy. Applied top
+    // down, a reused node's ancestors are all private too, so no other
+    // version can reach it.
+    static Node* own(Node*& link) {
+        Node* node = link;
+        if (node->refs.load(std::memory_order_acquire) == 1) return node;
+        Node* copy = new Node(*node);
+        release(node);
+        link = copy;
+        return copy;
+    }
+    
+    static int nodeHeight(const Node* node) { return node ? node->height : 0; }
+    
+    static void updateHeight(Node* node) {
+        node->height = 1 + std::max(nodeHeight(node->left), nodeHeight(node->right));
+    }
+    
+    // Rotations on an owned node; the child moved up is owned first
+    static void rotateLeft(Node*& link) {
+        Node* node = link;
+        Node* pivot = own(node->right);
+        node->right = pivot->left;
+        pivot->left = node;
+        updateHeight(node);
+        updateHeight(pivot);
+        link = pivot;
+    }
+    
+    static void rotateRight(Node*& link) {
+        Node* node = link;
+        Node* pivot = own(node->left);
+        node->left = pivot->right;
+        pivot->right = node;
+        updateHeight(node);
+        updateHeight(pivot);
+        link = pivot;
+    }
+    
+    // Restore the AVL invariant at an owned node
+    static void rebalance(Node*& link) {
+        Node* node = link;
+        int factor = nodeHeight(node->left) - nodeHeight(node->right);
+        if (factor > 1) {
+            if (nodeHeight(node->left->left) < nodeHeight(node->left->right)) {
+                own(node->left);
+                rotateLeft(node->left);
+            }
+            rotateRight(link);
+        } else if (factor < -1) {
+            if (nodeHeight(node->right->right) < nodeHeight(node->right->left)) {
+                own(node->right);
+                rotateRight(node->right);
+            }
+            rotateLeft(link);
+        } else {
+            updateHeight(node);
+        }
+    }
+    
+    // Caller has checked that value is absent
+    static void insertAt(Node*& link, const T& value) {
+        if (!link) {
+            link = new Node(value);
+            return;
+        }
+        Node* node = own(link);
+        if (value < node->key) insertAt(node->left, value);
+        else insertAt(node->right, value);
+        rebalance(link);
+    }
+    
+    // Unlink the minimum of a non-empty subtree and return it, owned
+    static Node* detachMin(Node*& link) {
+        Node* node = own(link);
+        if (!node->left) {
+            link = node->right;
+            node->right = nullptr;
+            return node;
+        }
+        Node* min = detachMin(node->left);
+        rebalance(link);
+        return min;
+    }
+    
+    // Caller has checked that value is present
+    static void removeAt(Node*& link, const T& value) {
+        Node* node = own(link);
+        if (value < node->key) {
+            removeAt(node->left, value);
+        } else if (node->key < value) {
+            removeAt(node->right, value);
+        } else {
+            if (!node->left || !node->right) {
+                // The child's subtree is unchanged and may be shared: link
+                // it in without touching it
+                link = node->left ? node->left : node->right;
+                node->left = node->right = nullptr;
+                release(node);
+                return;
+            }
+            Node* replacement = detachMin(node->right);
+            replacement->left = node->left;
+            replacement->right = node->right;
+            node->left = node->right = nullptr;
+            release(node);
+            link = replacement;
+        }
+        rebalance(link);
+    }
+    
+    static Node* buildBalanced(const T* keys, size_t n) {
+        if (n == 0) return nullptr;
+        size_t mid = n / 2;
+        Node* node = new Node(keys[mid]);
+        try {
+            node->left = buildBalanced(keys, mid);
+            node->right = buildBalanced(keys + mid + 1, n - mid - 1);
+        } catch (...) {
+            release(node);
+            throw;
+        }
+        updateHeight(node);
+        return node;
+    }
+    
+    const Node* findNode(const T& value) const {
+        const Node* node = root_;
+        while (node) {
+            if (value < node->key) node = node->left;
+            else if (node->key < value) node = node->right;
+            else return node;
+        }
+        return nullptr;
+    }
+
+public:
+    using value_type = T;
+    
+    // In-order forward iterator. Valid until this version is modified;
+    // iterate a snapshot to read while writing.
+    class Iterator {
+    private:
+        std::vector<const Node*> path_; // ancestors still to visit, innermost last
+        
+        void descend(const Node* node) {
+            for (; node; node = node->left) path_.push_back(node);
+        }
+        
+        friend class PersistentSearchTree;
+        explicit Iterator(const Node* root) { descend(root); }
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+        
+        Iterator() = default;
+        
+        reference operator*() const { return path_.back()->key; }
+        pointer operator->() const { return &path_.back()->key; }
+        
+        Iterator& operator++() {
+            const Node* node = path_.back();
+            path_.pop_back();
+            descend(node->right);
+            return *this;
+        }
+        
+        Iterator operator++(int) {
+            Iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+        
+        friend bool operator==(const Iterator& a, const Iterator& b) {
+            if (a.path_.empty() || b.path_.empty()) return a.path_.empty() == b.path_.empty();
+            return a.path_.back() == b.path_.back();
+        }
+        
+        friend bool operator!=(const Iterator& a, const Iterator& b) {
+            return !(a == b);
+        }
+    };
+    
+    // Constructors & Destructor
+    PersistentSearchTree() = default;
+    
+    PersistentSearchTree(std::initializer_list<T> init) {
+        for (const auto& item : init) insert(item);
+    }
+    
+    // Copies share every node: O(1)
+    PersistentSearchTree(const PersistentSearchTree& other) : root_(other.root_), size_(other.size_) {
+        retain(root_);
+    }
+    
+    PersistentSearchTree(PersistentSearchTree&& other) noexcept
+        : root_(std::exchange(other.root_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+    
+    PersistentSearchTree& operator=(const PersistentSearchTree& other) {
+        retain(other.root_); // first, so self-assignment is safe
+        release(root_);
+        root_ = other.root_;
+        size_ = other.size_;
+        return *this;
+    }
+    
+    PersistentSearchTree& operator=(PersistentSearchTree&& other) noexcept {
+        if (this != &other) {
+            release(root_);
+            root_ = std::exchange(other.root_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+    
+    ~PersistentSearchTree() { release(root_); }
+    
+    // Balanced tree from ascending input in O(n); equal neighbours are kept
+    // once. Throws std::invalid_argument if the input is not sorted.
+    template <typename InputIt>
+    static PersistentSearchTree fromSorted(InputIt first, InputIt last) {
+        std::vector<T> keys;
+        for (; first != last; ++first) {
+            if (!keys.empty()) {
+                if (*first < keys.back()) throw std::invalid_argument("fromSorted: input is not sorted");
+                if (!(keys.back() < *first)) continue;
+            }
+            keys.push_back(*first);
+        }
+        PersistentSearchTree tree;
+        tree.root_ = buildBalanced(keys.data(), keys.size());
+        tree.size_ = keys.size();
+        return tree;
+    }
+    
+    // An independent version with the current contents, in O(1). Later
+    // changes to either tree are invisible to the other.
+    [[nodiscard]] PersistentSearchTree snapshot() const { return *this; }
+    
+    // Capacity
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+    [[nodiscard]] size_t size() const { return size_; }
+    [[nodiscard]] int height() const { return nodeHeight(root_) - 1; }
+    
+    // Modifiers; true if the set changed. O(log n), allocating only for
+    // nodes still shared with another version.
+    bool insert(const T& value) {
+        if (findNode(value)) return false;
+        insertAt(root_, value);
+        ++size_;
+        return true;
+    }
+    
+    bool remove(const T& value) {
+        if (!findNode(value)) return false;
+        removeAt(root_, value);
+        --size_;
+        return true;
+    }
+    
+    void clear() {
+        release(std::exchange(root_, nullptr));
+        size_ = 0;
+    }
+    
+    // Iterators
+    [[nodiscard]] Iterator begin() const { return Iterator(root_); }
+    [[nodiscard]] Iterator end() const { return Iterator(); }
+    
+    // Lookup
+    [[nodiscard]] bool contains(const T& value) const { return findNode(value) != nullptr; }
+    
+    // Smallest key >= value
+    [[nodiscard]] std::optional<T> lower_bound(const T& value) const {
+        const Node* result = nullptr;
+        for (const Node* node = root_; node;) {
+            if (node->key < value) node = node->right;
+            else { result = node; node = node->left; }
+        }
+        return result ? std::optional<T>(result->key) : std::nullopt;
+    }
+    
+    [[nodiscard]] std::vector<T> inorderTraversal() const {
+        std::vector<T> result;
+        result.reserve(size_);
+        for (const T& key : *this) result.push_back(key);
+        return result;
+    }
+};
+
+} // namespace dsa
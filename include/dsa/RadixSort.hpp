@@ -0,0 +1,199 @@
+#pragma once
+
+/**
+ * @file RadixSort.hpp
+ * @brief LSD and MSD (American flag) radix sorts with key projections
+ * @author Neel Patel
+ * @version 1.0.0
+ *
+ * - Integer and floating-point keys: stable LSD radix sort, one byte per pass.
+ *   All byte histograms come from a single counting pass, and passes where
+ *   every key has the same byte are skipped.
+ * - String keys (anything convertible to std::string_view): in-place MSD
+ *   American flag sort with an explicit work stack. Not stable.
+ * - A projection selects the key, so structs sort by a field without a
+ *   comparator: radixSort(people, [](const Person& p) { return p.age; });
+ */
+
+#include "Sorting.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace dsa {
+namespace sort {
+
+namespace detail {
+    struct Identity {
+        template <typename T>
+        constexpr T&& operator()(T&& value) const noexcept { return std::forward<T>(value); }
+    };
+    
+    template <typename Proj, typename It>
+    using ProjectedKey = std::decay_t<std::invoke_result_t<Proj&, decltype(*std::declval<It>())>>;
+    
+    template <typename Key>
+    constexpr bool isRadixNumeric =
+        (std::is_integral_v<Key> && !std::is_same_v<Key, bool>) ||
+        (std::is_floating_point_v<Key> && (sizeof(Key) == 4 || sizeof(Key) == 8));
+    
+    // Map a key to an unsigned integer with the same ordering
+    template <typename Key>
+    auto radixKey(Key key) {
+        if constexpr (std::is_floating_point_v<Key>) {
+            using U = std::conditional_t<sizeof(Key) == 4, uint32_t, uint64_t>;
+            U bits;
+            std::memcpy(&bits, &key, sizeof(bits));
+            constexpr U sign = U(1) << (sizeof(U) * 8 - 1);
+            // Negative floats: reverse their order; positive: move above negatives
+            return (bits & sign) ? U(~bits) : U(bits | sign);
+        } else {
+            using U = std::make_unsigned_t<Key>;
+            if constexpr (std::is_signed_v<Key>) {
+                return U(U(key) ^ (U(1) << (sizeof(U) * 8 - 1)));
+            } else {
+                return U(key);
+            }
+        }
+    }
+    
+    constexpr std::ptrdiff_t kRadixInsertionThreshold = 64;
+    
+    template <typename RandomIt, typename Proj>
+    void lsdRadixSort(RandomIt first, RandomIt last, Proj proj) {
+        using T = IterValue<RandomIt>;
+        using Key = ProjectedKey<Proj, RandomIt>;
+        constexpr size_t kPasses = sizeof(Key);
+        auto digit = [&proj](const T& value, size_t pass) {
+            return static_cast<size_t>((radixKey(Key(proj(value))) >> (8 * pass)) & 0xFF);
+        };
+        
+        std::ptrdiff_t n = last - first;
+        if (n <= kRadixInsertionThreshold) {
+            detail::insertionSort(first, last, [&proj](const T& a, const T& b) {
+                return radixKey(Key(proj(a))) < radixKey(Key(proj(b)));
+            });
+            return;
+        }
+        
+        // One pass builds the histogram of every byte position
+        std::array<std::array<size_t, 256>, kPasses> counts{};
+        for (RandomIt it = first; it != last; ++it) {
+            auto key = radixKey(Key(proj(*it)));
+            for (size_t pass = 0; pass < kPasses; ++pass) {
+                ++counts[pass][(key >> (8 * pass)) & 0xFF];
+            }
+        }
+        
+        std::vector<T> buffer(std::make_move_iterator(first), std::make_move_iterator(last));
+        bool inBuffer = true;
+        auto scatter = [&](auto src, auto dst, size_t pass) {
+            std::array<size_t, 256> offsets;
+            size_t sum = 0;
+            for (size_t b = 0; b < 256; ++b) {
+                offsets[b] = sum;
+                sum += counts[pass][b];
+            }
+            for (std::ptrdiff_t i = 0; i < n; ++i) {
+                size_t d = digit(src[i], pass);
+                dst[offsets[d]++] = std::move(src[i]);
+            }
+        };
+        
+        for (size_t pass = 0; pass < kPasses; ++pass) {
+            // Every key shares this byte: the pass would be the identity
+            if (counts[pass][digit(inBuffer ? buffer[0] : *first, pass)] == static_cast<size_t>(n))
+                continue;
+            if (inBuffer) scatter(buffer.begin(), first, pass);
+            else scatter(first, buffer.begin(), pass);
+            inBuffer = !inBuffer;
+        }
+        if (inBuffer) std::move(buffer.begin(), buffer.end(), first);
+    }
+    
+    // In-place MSD radix sort on the bytes of string keys
+    template <typename RandomIt, typename Proj>
+    void americanFlagSort(RandomIt first, RandomIt last, Proj proj) {
+        auto keyOf = [&proj](const auto& value) { return std::string_view(proj(value)); };
+        struct Frame { RandomIt lo, hi; size_t depth; };
+        std::vector<Frame> work{{first, last, 0}};
+        
+        while (!work.empty()) {
+            auto [lo, hi, depth] = work.back();
+            work.pop_back();
+            
+            if (hi - lo <= kRadixInsertionThreshold) {
+                // All keys share their first `depth` bytes: compare the rest only
+                detail::insertionSort(lo, hi, [&](const auto& a, const auto& b) {
+                    return keyOf(a).substr(depth) < keyOf(b).substr(depth);
+                });
+                continue;
+            }
+            
+            // Bucket 0 holds keys that end at this depth, 1..256 the next byte
+            auto bucketOf = [&](const auto& value) -> size_t {
+                std::string_view key = keyOf(value);
+                return depth < key.size() ? size_t(static_cast<unsigned char>(key[depth])) + 1 : 0;
+            };
+            std::array<std::ptrdiff_t, 257> counts{};
+            for (RandomIt it = lo; it != hi; ++it) ++counts[bucketOf(*it)];
+            
+            std::array<std::ptrdiff_t, 257> next, end;
+            std::ptrdiff_t sum = 0;
+            for (size_t b = 0; b < 257; ++b) {
+                next[b] = sum;
+                sum += counts[b];
+                end[b] = sum;
+            }
+            
+            // Cycle each element into its bucket with swaps
+            for (size_t b = 0; b < 257; ++b) {
+                while (next[b] < end[b]) {
+                    size_t target = bucketOf(lo[next[b]]);
+                    if (target == b) ++next[b];
+                    else std::iter_swap(lo + next[b], lo + next[target]++);
+                }
+            }
+            
+            std::ptrdiff_t start = counts[0];
+            for (size_t b = 1; b < 257; ++b) {
+                if (counts[b] > 1) work.push_back({lo + start, lo + start + counts[b], depth + 1});
+                start += counts[b];
+            }
+        }
+    }
+}
+
+// Radix Sort - O(w * n) for w-byte numeric keys; O(total key bytes) for strings
+template <typename RandomIt, typename Proj = detail::Identity>
+void radixSort(RandomIt first, RandomIt last, Proj proj = Proj()) {
+    using Key = detail::ProjectedKey<Proj, RandomIt>;
+    if (last - first < 2) return;
+    if constexpr (detail::isRadixNumeric<Key>) {
+        detail::lsdRadixSort(first, last, proj);
+    } else {
+        using Projected = std::invoke_result_t<Proj&, decltype(*first)>;
+        static_assert(std::is_convertible_v<Key, std::string_view>,
+                      "radixSort needs an integral, float/double or string-like key");
+        static_assert(std::is_reference_v<Projected> || !std::is_same_v<Key, std::string>,
+                      "string key projections must return a reference or std::string_view");
+        detail::americanFlagSort(first, last, proj);
+    }
+}
+
+template <typename T, typename Proj = detail::Identity>
+void radixSort(std::vector<T>& arr, Proj proj = Proj()) {
+    radixSort(arr.begin(), arr.end(), proj);
+}
+
+template <typename Range, detail::EnableIfRange<Range> = 0, typename Proj = detail::Identity>
+void radixSort(Range&& range, Proj proj = Proj()) {
+    radixSort(std::begin(range), std::end(range), proj);
+}
+
+} // namespace sort
+} // namespace dsa
@@ -0,0 +1,257 @@
+#pragma once
+
+/**
+ * @file Selection.hpp
+ * @brief Partial sort, nth element and streaming top-k selection
+ * @author Neel Patel
+ * @version 1.0.0
+ *
+ * - partialSort: the k smallest elements in sorted order at the front
+ * - nthElement: introselect (quickselect on the introsort partitions) that
+ *   switches to median-of-medians pivots after too many bad partitions,
+ *   so the worst case stays O(n)
+ * - TopK<T, K>: bounded max-heap of the K smallest values seen so far,
+ *   for input that is streamed once and never stored
+ */
+
+#include "Sorting.hpp"
+
+#include <array>
+
+namespace dsa {
+namespace sort {
+
+namespace detail {
+    // Move the element at index i up a max-heap until its parent is not smaller
+    template <typename RandomIt, typename Compare>
+    void siftUp(RandomIt first, std::ptrdiff_t i, Compare comp) {
+        while (i > 0) {
+            std::ptrdiff_t parent = (i - 1) / 2;
+            if (!comp(first[parent], first[i])) return;
+            std::iter_swap(first + parent, first + i);
+            i = parent;
+        }
+    }
+    
+    template <typename RandomIt, typename Compare>
+    void heapPartialSort(RandomIt first, RandomIt middle, RandomIt last, Compare comp) {
+        std::ptrdiff_t k = middle - first;
+        for (std::ptrdiff_t i = k / 2 - 1; i >= 0; --i) {
+            heapify(first, k, i, comp);
+        }
+        // The heap top is the largest of the k smallest seen so far
+        for (RandomIt it = middle; it != last; ++it) {
+            if (comp(*it, *first)) {
+                std::iter_swap(it, first);
+                heapify(first, k, 0, comp);
+            }
+        }
+        for (std::ptrdiff_t i = k - 1; i > 0; --i) {
+            std::iter_swap(first, first + i);
+            heapify(first, i, 0, comp);
+        }
+    }
+    
+    template <typename RandomIt, typename Compare>
+    void select(RandomIt first, RandomIt nth, RandomIt last, Compare comp, int badAllowed);
+    
+    // Pivot with at least 3n/10 elements on either side: the median of the
+    // medians of groups of five. The group medians are gathered at the front.
+    template <typename RandomIt, typename Compare>
+    RandomIt medianOfMedians(RandomIt first, RandomIt last, Compare comp) {
+        std::ptrdiff_t n = last - first;
+        RandomIt medians = first;
+        for (std::ptrdiff_t lo = 0; lo < n; lo += 5) {
+            std::ptrdiff_t hi = std::min<std::ptrdiff_t>(lo + 5, n);
+            detail::insertionSort(first + lo, first + hi, comp);
+            std::iter_swap(medians++, first + (lo + (hi - lo) / 2));
+        }
+        RandomIt mid = first + (medians - first) / 2;
+        select(first, mid, medians, comp, 0);
+        return mid;
+    }
+    
+    // Introselect: partition like introSortLoop but only continue into the
+    // side holding nth. Once badAllowed runs out, every pivot comes from
+    // medianOfMedians.
+    template <typename RandomIt, typename Compare>
+    void select(RandomIt first, RandomIt nth, RandomIt last, Compare comp, int badAllowed) {
+        bool leftmost = true;
+        while (true) {
+            std::ptrdiff_t size = last - first;
+            if (size <= kInsertionSortThreshold) {
+                detail::insertionSort(first, last, comp);
+                return;
+            }
+            
+            std::ptrdiff_t half = size / 2;
+            if (badAllowed == 0) {
+                std::iter_swap(first, medianOfMedians(first, last, comp));
+            } else if (size > kNintherThreshold) {
+                sort3(first, first + half, last - 1, comp);
+                sort3(first + 1, first + (half - 1), last - 2, comp);
+                sort3(first + 2, first + (half + 1), last - 3, comp);
+                sort3(first + (half - 1), first + half, first + (half + 1), comp);
+                std::iter_swap(first, first + half);
+            } else {
+                sort3(first + half, first, last - 1, comp);
+            }
+            
+            // Pivot equal to its left neighbour: the run of equal keys is final
+            if (!leftmost && !comp(*(first - 1), *first)) {
+                RandomIt equalEnd = partitionLeft(first, last, comp);
+                if (nth <= equalEnd) return;
+                first = equalEnd + 1;
+                continue;
+            }
+            
+            RandomIt pivotPos = partitionRight(first, last, comp).first;
+            std::ptrdiff_t leftSize = pivotPos - first;
+            std::ptrdiff_t rightSize = last - (pivotPos + 1);
+            if (badAllowed > 0 && (leftSize < size / 8 || rightSize < size / 8)) {
+                --badAllowed;
+                breakPatterns<Compare>(first, pivotPos);
+                breakPatterns<Compare>(pivotPos + 1, last);
+            }
+            
+            if (nth == pivotPos) return;
+            if (nth < pivotPos) {
+                last = pivotPos;
+            } else {
+                first = pivotPos + 1;
+                leftmost = false;
+            }
+        }
+    }
+    
+    // Above this k (and k > n / 16), selecting and then sorting the front
+    // beats a heap of k elements
+    constexpr std::ptrdiff_t kPartialSortHeapLimit = 1024;
+}
+
+// Nth Element - O(n) worst case; *nth ends up as in the sorted order, with
+// no element before it greater and none after it smaller
+template <typename RandomIt, typename Compare = std::less<detail::IterValue<RandomIt>>>
+void nthElement(RandomIt first, RandomIt nth, RandomIt last, Compare comp = Compare()) {
+    std::ptrdiff_t n = last - first;
+    if (n < 2 || nth == last) return;
+    int log2n = 0;
+    while (n >>= 1) ++log2n;
+    detail::select(first, nth, last, comp, log2n);
+}
+
+template <typename T, typename Compare = std::less<T>>
+void nthElement(std::vector<T>& arr, size_t k, Compare comp = Compare()) {
+    if (k < arr.size()) nthElement(arr.begin(), arr.begin() + k, arr.end(), comp);
+}
+
+template <typename Range, detail::EnableIfRange<Range> = 0,
+          typename Compare = std::less<detail::RangeValue<Range>>>
+void nthElement(Range&& range, size_t k, Compare comp = Compare()) {
+    auto first = std::begin(range);
+    auto last = std::end(range);
+    if (static_cast<std::ptrdiff_t>(k) < last - first) nthElement(first, first + k, last, comp);
+}
+
+// Partial Sort - O(n log k) with a heap for small k, O(n + k log k) otherwise;
+// [first, middle) receives the smallest elements in order, the rest is unordered
+template <typename RandomIt, typename Compare = std::less<detail::IterValue<RandomIt>>>
+void partialSort(RandomIt first, RandomIt middle, RandomIt last, Compare comp = Compare()) {
+    std::ptrdiff_t k = middle - first;
+    std::ptrdiff_t n = last - first;
+    if (k == 0) return;
+    if (k <= detail::kPartialSortHeapLimit || k <= n / 16) {
+        detail::heapPartialSort(first, middle, last, comp);
+    } else {
+        nthElement(first, middle - 1, last, comp);
+        detail::introSort(first, middle - 1, comp);
+    }
+}
+
+template <typename T, typename Compare = std::less<T>>
+void partialSort(std::vector<T>& arr, size_t k, Compare comp = Compare()) {
+    k = std::min(k, arr.size());
+    partialSort(arr.begin(), arr.begin() + k, arr.end(), comp);
+}
+
+template <typename Range, detail::EnableIfRange<Range> = 0,
+          typename Compare = std::less<detail::RangeValue<Range>>>
+void partialSort(Range&& range, size_t k, Compare comp = Compare()) {
+    auto first = std::begin(range);
+    auto last = std::end(range);
+    k = std::min<size_t>(k, static_cast<size_t>(last - first));
+    partialSort(first, first + k, last, comp);
+}
+
+// Keeps the K smallest values (by comp) pushed so far in O(K) space;
+// each push is O(1) when the value is rejected, O(log K) otherwise
+template <typename T, size_t K, typename Compare = std::less<T>>
+class TopK {
+    static_assert(K > 0, "TopK needs room for at least one element");
+
+public:
+    explicit TopK(Compare comp = Compare()) : comp_(comp) {}
+    
+    void push(const T& value) {
+        if (size_ < K) {
+            heap_[size_] = value;
+            detail::siftUp(heap_.begin(), static_cast<std::ptrdiff_t>(size_++), comp_);
+        } else if (comp_(value, heap_[0])) {
+            heap_[0] = value;
+            detail::heapify(heap_.begin(), static_cast<std::ptrdiff_t>(K), 0, comp_);
+        }
+    }
+    
+    void push(T&& value) {
+        if (size_ < K) {
+            heap_[size_] = std::move(value);
+            detail::siftUp(heap_.begin(), static_cast<std::ptrdiff_t>(size_++), comp_);
+        } else if (comp_(value, heap_[0])) {
+            heap_[0] = std::move(value);
+            detail::heapify(heap_.begin(), static_cast<std::ptrdiff_t>(K), 0, comp_);
+        }
+    }
+    
+    template <typename InputIt>
+    void push(InputIt first, InputIt last) {
+        for (; first != last; ++first) push(*first);
+    }
+    
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+    [[nodiscard]] size_t size() const { return size_; }
+    [[nodiscard]] static constexpr size_t capacity() { return K; }
+    
+    // Largest value kept: anything not smaller is rejected once full
+    [[nodiscard]] const T& threshold() const { return heap_[0]; }
+    
+    // The kept values, smallest first
+    [[nodiscard]] std::vector<T> sorted() const {
+        std::vector<T> result(heap_.begin(), heap_.begin() + size_);
+        detail::introSort(result.begin(), result.end(), comp_);
+        return result;
+    }
+    
+    void clear() { size_ = 0; }
+
+private:
+    std::array<T, K> heap_{};
+    size_t size_ = 0;
+    Compare comp_;
+};
+
+// The K smallest elements of a single pass over [first, last), sorted
+template <size_t K, typename InputIt, typename Compare = std::less<detail::IterValue<InputIt>>>
+std::vector<detail::IterValue<InputIt>> topK(InputIt first, InputIt last, Compare comp = Compare()) {
+    TopK<detail::IterValue<InputIt>, K, Compare> top(comp);
+    top.push(first, last);
+    return top.sorted();
+}
+
+template <size_t K, typename Range, detail::EnableIfRange<Range> = 0,
+          typename Compare = std::less<detail::RangeValue<Range>>>
+std::vector<detail::RangeValue<Range>> topK(const Range& range, Compare comp = Compare()) {
+    return topK<K>(std::begin(range), std::end(range), comp);
+}
+
+} // namespace sort
+} // namespace dsa
@@ -0,0 +1,203 @@
+#pragma once
+
+/**
+ * @file Serialization.hpp
+ * @brief Versioned binary file format for containers of trivially copyable T
+ * @author Neel Patel
+ * @version 1.0.0
+ *
+ * A file is a 64-byte FileHeader followed by sections, each starting on a
+ * 64-byte boundary so a mapped file can be used in place:
+ *
+ *   Sequence    elements[count]                      (LinkedList)
+ *   SortedKeys  keys[count], strictly increasing     (BinarySearchTree)
+ *   Eytzinger   keys[count], tree[count + 1],        (StaticSearchTree)
+ *               order[count + 1] as uint64_t
+ *
+ * Elements are raw native-endian bytes. Loading checks the magic, version,
+ * byte order, element size and layout, and throws std::runtime_error on
+ * any mismatch or truncated file.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace dsa {
+namespace io {
+
+enum class Layout : uint32_t {
+    Sequence = 1,
+    SortedKeys = 2,
+    Eytzinger = 3,
+};
+
+inline constexpr uint32_t kFormatVersion = 1;
+inline constexpr size_t kSectionAlignment = 64;
+
+struct FileHeader {
+    char magic[8];          // "DSAFILE" and a NUL
+    uint32_t version;
+    uint32_t layout;
+    uint32_t byteOrder;     // 0x01020304 as written by the producer
+    uint32_t elementSize;
+    uint32_t elementAlign;
+    uint32_t reserved0;
+    uint64_t count;
+    uint64_t reserved[3];
+};
+
+static_assert(sizeof(FileHeader) == kSectionAlignment, "header must fill one section");
+
+namespace detail {
+    inline constexpr char kMagic[8] = {'D', 'S', 'A', 'F', 'I', 'L', 'E', '\0'};
+    inline constexpr uint32_t kByteOrderMark = 0x01020304;
+    
+    constexpr size_t alignSection(size_t offset) {
+        return (offset + kSectionAlignment - 1) / kSectionAlignment * kSectionAlignment;
+    }
+    
+    // Byte offsets of the sections for `count` elements of T; an empty
+    // file is just the header
+    template <typename T>
+    struct Sections {
+        size_t keys;
+        size_t tree;  // Eytzinger only
+        size_t order; // Eytzinger only
+        size_t end;
+        
+        Sections(size_t count, Layout layout) {
+            keys = sizeof(FileHeader);
+            tree = alignSection(keys + count * sizeof(T));
+            if (layout == Layout::Eytzinger && count > 0) {
+                order = alignSection(tree + (count + 1) * sizeof(T));
+                end = order + (count + 1) * sizeof(uint64_t);
+            } else {
+                order = tree;
+                end = keys + count * sizeof(T);
+            }
+        }
+    };
+    
+    template <typename T>
+    FileHeader makeHeader(Layout layout, size_t count) {
+        static_assert(std::is_trivially_copyable_v<T>, "binary files require a trivially copyable T");
+        static_assert(alignof(T) <= kSectionAlignment, "element alignment exceeds the section alignment");
+        FileHeader header{};
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kFormatVersion;
+        header.layout = static_cast<uint32_t>(layout);
+        header.byteOrder = kByteOrderMark;
+        header.elementSize = sizeof(T);
+        header.elementAlign = alignof(T);
+        header.count = count;
+        return header;
+    }
+    
+    // Validate a header of a `fileSize`-byte file against T; returns its layout
+    template <typename T>
+    Layout checkHeader(const FileHeader& header, size_t fileSize, std::initializer_list<Layout> accepted,
+                       const std::filesystem::path& path) {
+        auto fail = [&path](const char* what) {
+            throw std::runtime_error(path.string() + ": " + what);
+        };
+        if (fileSize < sizeof(FileHeader) || std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+            fail("not a dsa binary file");
+        }
+        if (header.version != kFormatVersion) fail("unsupported format version");
+        if (header.byteOrder != kByteOrderMark) fail("written with a different byte order");
+        if (header.elementSize != sizeof(T) || header.elementAlign != alignof(T)) {
+            fail("element type does not match");
+        }
+        Layout layout = static_cast<Layout>(header.layout);
+        if (std::find(accepted.begin(), accepted.end(), layout) == accepted.end()) fail("unexpected layout");
+        if (header.count > (fileSize - sizeof(FileHeader)) / sizeof(T) ||
+            Sections<T>(header.count, layout).end > fileSize) {
+            fail("file is truncated");
+        }
+        return layout;
+    }
+    
+    // Buffered writer for the header and sections of one file
+    class FileWriter {
+    public:
+        explicit FileWriter(const std::filesystem::path& path)
+            : path_(path), out_(path, std::ios::binary | std::ios::trunc) {
+            if (!out_) throw std::runtime_error("cannot open " + path.string() + " for writing");
+        }
+        
+        void write(const void* data, size_t bytes) {
+            out_.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+            offset_ += bytes;
+        }
+        
+        // Pad with zeros up to the given offset
+        void seek(size_t offset) {
+            static constexpr char zeros[kSectionAlignment] = {};
+            while (offset_ < offset) write(zeros, std::min(offset - offset_, sizeof(zeros)));
+        }
+        
+        // Elements of a range, staged through a small buffer
+        template <typename T, typename It>
+        void writeRange(It first, It last) {
+            constexpr size_t kChunk = std::max<size_t>((size_t(64) << 10) / sizeof(T), 1);
+            std::vector<T> chunk;
+            chunk.reserve(kChunk);
+            for (; first != last; ++first) {
+                chunk.push_back(*first);
+                if (chunk.size() == kChunk) {
+                    write(chunk.data(), chunk.size() * sizeof(T));
+                    chunk.clear();
+                }
+            }
+            write(chunk.data(), chunk.size() * sizeof(T));
+        }
+        
+        void close() {
+            out_.close();
+            if (!out_) throw std::runtime_error("error writing " + path_.string());
+        }
+    
+    private:
+        std::filesystem::path path_;
+        std::ofstream out_;
+        size_t offset_ = 0;
+    };
+    
+    // Write a Sequence or SortedKeys file of `count` elements from a range
+    template <typename T, typename It>
+    void saveElements(const std::filesystem::path& path, Layout layout, It first, It last, size_t count) {
+        FileHeader header = makeHeader<T>(layout, count);
+        FileWriter out(path);
+        out.write(&header, sizeof(header));
+        out.writeRange<T>(first, last);
+        out.close();
+    }
+    
+    // Read the leading element section of a file in one of the accepted layouts
+    template <typename T>
+    std::vector<T> loadElements(const std::filesystem::path& path, std::initializer_list<Layout> accepted) {
+        static_assert(std::is_trivially_copyable_v<T>, "binary files require a trivially copyable T");
+        std::ifstream in(path, std::ios::binary);
+        if (!in) throw std::runtime_error("cannot open " + path.string());
+        size_t fileSize = static_cast<size_t>(std::filesystem::file_size(path));
+        FileHeader header{};
+        in.read(reinterpret_cast<char*>(&header), sizeof(header));
+        checkHeader<T>(header, in ? fileSize : 0, accepted, path);
+        std::vector<T> values(header.count);
+        in.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+        if (!in) throw std::runtime_error("error reading " + path.string());
+        return values;
+    }
+}
+
+} // namespace io
+} // namespace dsa
@@ -0,0 +1,636 @@
+#pragma once
+
+/**
+ * @file SimdSort.hpp
+ * @brief SIMD sorting-network and partition kernels for int32/float/double
+ * @author Neel Patel
+ * @version 1.0.0
+ *
+ * - sortBlock(): bitonic sorting network over vector registers for blocks
+ *   of up to 64 elements (padded to a power of two with +max/+inf)
+ * - partition(): in-place vectorized partition around a pivot value
+ * - AVX-512 and AVX2 kernels are picked at runtime from the CPU features,
+ *   NEON is used on AArch64; anything else falls back to scalar code
+ *
+ * The quickSort/introSort engine calls these automatically for int32_t,
+ * float and double with the default comparator. Floating-point input must
+ * not contain NaN (std::less is not a strict weak order with NaN either).
+ * Define DSA_NO_SIMD to compile the scalar paths only.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+// Vector arguments between force-inlined helpers never cross an ABI
+// boundary; GCC 12 also misreports its own AVX-512 intrinsics
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+#if !defined(DSA_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DSA_SIMD_X86 1
+#include <immintrin.h>
+#define DSA_TARGET_AVX2 __attribute__((target("avx2")))
+#define DSA_TARGET_AVX512 __attribute__((target("avx512f")))
+#elif !defined(DSA_NO_SIMD) && defined(__GNUC__) && defined(__aarch64__) && defined(__ARM_NEON)
+#define DSA_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+// Shared kernels are force-inlined into each target-specific entry point
+#if defined(__GNUC__)
+#define DSA_SIMD_INLINE inline __attribute__((always_inline))
+#else
+#define DSA_SIMD_INLINE inline
+#endif
+
+namespace dsa {
+namespace sort {
+namespace simd {
+
+enum class Isa { Scalar, Neon, Avx2, Avx512 };
+
+inline Isa detectIsa() {
+#if defined(DSA_SIMD_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return Isa::Avx512;
+    if (__builtin_cpu_supports("avx2")) return Isa::Avx2;
+    return Isa::Scalar;
+#elif defined(DSA_SIMD_NEON)
+    return Isa::Neon;
+#else
+    return Isa::Scalar;
+#endif
+}
+
+// Instruction set used by the kernels; detected once per process
+inline Isa activeIsa() {
+    static const Isa isa = detectIsa();
+    return isa;
+}
+
+inline const char* isaName(Isa isa) {
+    switch (isa) {
+        case Isa::Avx512: return "avx512";
+        case Isa::Avx2: return "avx2";
+        case Isa::Neon: return "neon";
+        default: return "scalar";
+    }
+}
+
+// Largest block sortBlock() accepts
+constexpr size_t kMaxBlock = 64;
+
+template <typename T>
+constexpr bool isKey = std::is_same_v<T, int32_t> || std::is_same_v<T, float> ||
+                       std::is_same_v<T, double>;
+
+// True when a sort over [It, It) with Compare can use the kernels: a
+// supported key type, ascending std::less order and contiguous storage
+template <typename It, typename Compare>
+constexpr bool accelerated() {
+    using T = typename std::iterator_traits<It>::value_type;
+    if constexpr (!isKey<T>) {
+        return false;
+    } else {
+        constexpr bool ascending = std::is_same_v<Compare, std::less<T>> ||
+                                   std::is_same_v<Compare, std::less<>>;
+        constexpr bool contiguous = std::is_same_v<It, T*> ||
+                                    std::is_same_v<It, typename std::vector<T>::iterator>;
+        return ascending && contiguous;
+    }
+}
+
+namespace detail {
+    // Bitmask of the lanes whose index has `bit` set
+    template <int Lanes>
+    constexpr unsigned lanePattern(int bit) {
+        unsigned bits = 0;
+        for (int lane = 0; lane < Lanes; ++lane) {
+            if (lane & bit) bits |= 1u << lane;
+        }
+        return bits;
+    }
+    
+    // For every lane mask: byte shuffle that packs the selected lanes to the
+    // bottom and the rest to the top. Each lane spans `Scale` shuffle units.
+    template <int Lanes, int Scale>
+    constexpr auto makePartitionTable() {
+        std::array<std::array<uint8_t, Lanes * Scale>, (1 << Lanes)> table{};
+        for (int bits = 0; bits < (1 << Lanes); ++bits) {
+            int out = 0;
+            for (int pass = 0; pass < 2; ++pass) {
+                for (int lane = 0; lane < Lanes; ++lane) {
+                    if (((bits >> lane) & 1) != (pass == 0)) continue;
+                    for (int s = 0; s < Scale; ++s) {
+                        table[bits][out++] = static_cast<uint8_t>(lane * Scale + s);
+                    }
+                }
+            }
+        }
+        return table;
+    }
+    
+    template <typename T>
+    constexpr T sentinel() {
+        if constexpr (std::numeric_limits<T>::has_infinity) return std::numeric_limits<T>::infinity();
+        else return std::numeric_limits<T>::max();
+    }
+    
+    // Bitonic network over Regs registers. Comparators are written so that
+    // every input value survives, including -0.0/+0.0 ties.
+    template <typename V, int Regs>
+    DSA_SIMD_INLINE void bitonicSort(typename V::Reg* v) {
+        constexpr int L = V::kLanes;
+        constexpr int n = Regs * L;
+        constexpr unsigned full = (1u << L) - 1;
+        for (int k = 2; k <= n; k <<= 1) {
+            for (int j = k >> 1; j > 0; j >>= 1) {
+                if (j >= L) {
+                    // Partners live in different registers
+                    int stride = j / L;
+                    for (int r = 0; r + stride < Regs; ++r) {
+                        if (r & stride) continue;
+                        auto lo = V::min(v[r], v[r + stride]);
+                        auto hi = V::max(v[r + stride], v[r]);
+                        bool ascending = ((r * L) & k) == 0;
+                        v[r] = ascending ? lo : hi;
+                        v[r + stride] = ascending ? hi : lo;
+                    }
+                    continue;
+                }
+                
+                // Partners are lanes of the same register: shuffle, then keep
+                // the max in the upper lane of each pair (flipped when the
+                // block sorts descending)
+                auto index = V::xorIndex(j);
+                unsigned upper = lanePattern<L>(j);
+                if (k < L) upper ^= lanePattern<L>(k);
+                auto keepMax = V::mask(upper);
+                auto keepMaxDescending = V::mask(upper ^ full);
+                for (int r = 0; r < Regs; ++r) {
+                    auto partner = V::permute(v[r], index);
+                    auto lo = V::min(v[r], partner);
+                    auto hi = V::max(v[r], partner);
+                    bool descending = k >= L && ((r * L) & k) != 0;
+                    v[r] = V::blend(descending ? keepMaxDescending : keepMax, lo, hi);
+                }
+            }
+        }
+    }
+    
+    // Sort the first regs * kLanes elements of buf with the matching network
+    template <typename V, int Regs, typename T>
+    DSA_SIMD_INLINE void sortRegisters(T* buf, int regs) {
+        if constexpr (Regs * V::kLanes < static_cast<int>(kMaxBlock)) {
+            if (regs > Regs) {
+                sortRegisters<V, Regs * 2>(buf, regs);
+                return;
+            }
+        }
+        typename V::Reg v[Regs];
+        for (int r = 0; r < Regs; ++r) v[r] = V::load(buf + r * V::kLanes);
+        bitonicSort<V, Regs>(v);
+        for (int r = 0; r < Regs; ++r) V::store(buf + r * V::kLanes, v[r]);
+    }
+    
+    template <typename V, typename T>
+    DSA_SIMD_INLINE void sortBlock(T* data, size_t n) {
+        size_t padded = V::kLanes;
+        while (padded < n) padded *= 2;
+        
+        T buf[kMaxBlock];
+        std::copy(data, data + n, buf);
+        for (size_t i = n; i < padded; ++i) buf[i] = sentinel<T>();
+        sortRegisters<V, 1>(buf, static_cast<int>(padded / V::kLanes));
+        std::copy(buf, buf + n, data);
+    }
+    
+    // Scatter `count` elements in `src` into the gap [left, right), which has
+    // exactly that many free slots: smaller than pivot left, the rest right.
+    template <typename T>
+    DSA_SIMD_INLINE T* distribute(const T* src, size_t count, T pivot, T* left, T* right) {
+        for (size_t i = 0; i < count; ++i) {
+            T x = src[i];
+            bool less = x < pivot;
+            *left = x;
+            *(right - 1) = x;
+            left += less;
+            right -= !less;
+        }
+        return left;
+    }
+    
+    // Two vectors are held back in registers so that each store can write a
+    // whole vector into free space on both sides; every loop iteration reads
+    // from the side with less room left.
+    template <typename V, typename T>
+    DSA_SIMD_INLINE T* partition(T* first, T* last, T pivot) {
+        constexpr int L = V::kLanes;
+        T rest[3 * L];
+        size_t n = static_cast<size_t>(last - first);
+        if (n < 2 * L) {
+            std::copy(first, last, rest);
+            return distribute(rest, n, pivot, first, last);
+        }
+        
+        auto p = V::set1(pivot);
+        auto head = V::load(first);
+        auto tail = V::load(last - L);
+        T* readLeft = first + L;
+        T* readRight = last - L;
+        T* writeLeft = first;
+        T* writeRight = last;
+        while (readRight - readLeft >= L) {
+            typename V::Reg v;
+            if (readLeft - writeLeft <= writeRight - readRight) {
+                v = V::load(readLeft);
+                readLeft += L;
+            } else {
+                readRight -= L;
+                v = V::load(readRight);
+            }
+            V::split(v, p, writeLeft, writeRight);
+        }
+        
+        size_t tailCount = static_cast<size_t>(readRight - readLeft);
+        std::copy(readLeft, readRight, rest);
+        V::store(rest + tailCount, head);
+        V::store(rest + tailCount + L, tail);
+        return distribute(rest, tailCount + 2 * L, pivot, writeLeft, writeRight);
+    }
+}
+
+#if defined(DSA_SIMD_X86)
+namespace x86 {
+    inline constexpr auto kPartition8x32 = detail::makePartitionTable<8, 1>();
+    inline constexpr auto kPartition4x64 = detail::makePartitionTable<4, 2>();
+    
+    template <typename T> struct Avx2;
+    template <typename T> struct Avx512;
+    
+    template <>
+    struct Avx2<int32_t> {
+        using Reg = __m256i;
+        using Mask = __m256i;
+        static constexpr int kLanes = 8;
+        
+        DSA_TARGET_AVX2 static Reg load(const int32_t* p) {
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        }
+        DSA_TARGET_AVX2 static void store(int32_t* p, Reg v) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+        }
+        DSA_TARGET_AVX2 static Reg set1(int32_t x) { return _mm256_set1_epi32(x); }
+        DSA_TARGET_AVX2 static Reg min(Reg a, Reg b) { return _mm256_min_epi32(a, b); }
+        DSA_TARGET_AVX2 static Reg max(Reg a, Reg b) { return _mm256_max_epi32(a, b); }
+        DSA_TARGET_AVX2 static __m256i xorIndex(int j) {
+            return _mm256_xor_si256(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(j));
+        }
+        DSA_TARGET_AVX2 static Reg permute(Reg v, __m256i index) {
+            return _mm256_permutevar8x32_epi32(v, index);
+        }
+        DSA_TARGET_AVX2 static Mask mask(unsigned bits) {
+            const __m256i lanes = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+            return _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(int(bits)), lanes), lanes);
+        }
+        DSA_TARGET_AVX2 static Reg blend(Mask m, Reg a, Reg b) { return _mm256_blendv_epi8(a, b, m); }
+        DSA_TARGET_AVX2 static void split(Reg v, Reg pivot, int32_t*& left, int32_t*& right) {
+            unsigned bits = unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(pivot, v))));
+            __m256i index = _mm256_cvtepu8_epi32(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(kPartition8x32[bits].data())));
+            Reg packed = permute(v, index);
+            store(left, packed);
+            store(right - kLanes, packed);
+            int count = __builtin_popcount(bits);
+            left += count;
+            right -= kLanes - count;
+        }
+    };
+    
+    template <>
+    struct Avx2<float> {
+        using Reg = __m256;
+        using Mask = __m256;
+        static constexpr int kLanes = 8;
+        
+        DSA_TARGET_AVX2 static Reg load(const float* p) { return _mm256_loadu_ps(p); }
+        DSA_TARGET_AVX2 static void store(float* p, Reg v) { _mm256_storeu_ps(p, v); }
+        DSA_TARGET_AVX2 static Reg set1(float x) { return _mm256_set1_ps(x); }
+        DSA_TARGET_AVX2 static Reg min(Reg a, Reg b) { return _mm256_min_ps(a, b); }
+        DSA_TARGET_AVX2 static Reg max(Reg a, Reg b) { return _mm256_max_ps(a, b); }
+        DSA_TARGET_AVX2 static __m256i xorIndex(int j) { return Avx2<int32_t>::xorIndex(j); }
+        DSA_TARGET_AVX2 static Reg permute(Reg v, __m256i index) {
+            return _mm256_permutevar8x32_ps(v, index);
+        }
+        DSA_TARGET_AVX2 static Mask mask(unsigned bits) {
+            return _mm256_castsi256_ps(Avx2<int32_t>::mask(bits));
+        }
+        DSA_TARGET_AVX2 static Reg blend(Mask m, Reg a, Reg b) { return _mm256_blendv_ps(a, b, m); }
+        DSA_TARGET_AVX2 static void split(Reg v, Reg pivot, float*& left, float*& right) {
+            unsigned bits = unsigned(_mm256_movemask_ps(_mm256_cmp_ps(v, pivot, _CMP_LT_OQ)));
+            __m256i index = _mm256_cvtepu8_epi32(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(kPartition8x32[bits].data())));
+            Reg packed = permute(v, index);
+            store(left, packed);
+            store(right - kLanes, packed);
+            int count = __builtin_popcount(bits);
+            left += count;
+            right -= kLanes - count;
+        }
+    };
+    
+    template <>
+    struct Avx2<double> {
+        using Reg = __m256d;
+        using Mask = __m256d;
+        static constexpr int kLanes = 4;
+        
+        DSA_TARGET_AVX2 static Reg load(const double* p) { return _mm256_loadu_pd(p); }
+        DSA_TARGET_AVX2 static void store(double* p, Reg v) { _mm256_storeu_pd(p, v); }
+        DSA_TARGET_AVX2 static Reg set1(double x) { return _mm256_set1_pd(x); }
+        DSA_TARGET_AVX2 static Reg min(Reg a, Reg b) { return _mm256_min_pd(a, b); }
+        DSA_TARGET_AVX2 static Reg max(Reg a, Reg b) { return _mm256_max_pd(a, b); }
+        // Each double moves as a pair of 32-bit lanes
+        DSA_TARGET_AVX2 static __m256i xorIndex(int j) { return Avx2<int32_t>::xorIndex(2 * j); }
+        DSA_TARGET_AVX2 static Reg permute(Reg v, __m256i index) {
+            return _mm256_castsi256_pd(_mm256_permutevar8x32_epi32(_mm256_castpd_si256(v), index));
+        }
+        DSA_TARGET_AVX2 static Mask mask(unsigned bits) {
+            const __m256i lanes = _mm256_setr_epi64x(1, 2, 4, 8);
+            return _mm256_castsi256_pd(_mm256_cmpeq_epi64(
+                _mm256_and_si256(_mm256_set1_epi64x(bits), lanes), lanes));
+        }
+        DSA_TARGET_AVX2 static Reg blend(Mask m, Reg a, Reg b) { return _mm256_blendv_pd(a, b, m); }
+        DSA_TARGET_AVX2 static void split(Reg v, Reg pivot, double*& left, double*& right) {
+            unsigned bits = unsigned(_mm256_movemask_pd(_mm256_cmp_pd(v, pivot, _CMP_LT_OQ)));
+            __m256i index = _mm256_cvtepu8_epi32(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(kPartition4x64[bits].data())));
+            Reg packed = permute(v, index);
+            store(left, packed);
+            store(right - kLanes, packed);
+            int count = __builtin_popcount(bits);
+            left += count;
+            right -= kLanes - count;
+        }
+    };
+    
+    template <>
+    struct Avx512<int32_t> {
+        using Reg = __m512i;
+        using Mask = __mmask16;
+        static constexpr int kLanes = 16;
+        
+        DSA_TARGET_AVX512 static Reg load(const int32_t* p) { return _mm512_loadu_si512(p); }
+        DSA_TARGET_AVX512 static void store(int32_t* p, Reg v) { _mm512_storeu_si512(p, v); }
+        DSA_TARGET_AVX512 static Reg set1(int32_t x) { return _mm512_set1_epi32(x); }
+        DSA_TARGET_AVX512 static Reg min(Reg a, Reg b) { return _mm512_min_epi32(a, b); }
+        DSA_TARGET_AVX512 static Reg max(Reg a, Reg b) { return _mm512_max_epi32(a, b); }
+        DSA_TARGET_AVX512 static __m512i xorIndex(int j) {
+            return _mm512_xor_si512(_mm512_set_epi32(15, 14, 13, 12, 11, 10, 9, 8,
+                                                     7, 6, 5, 4, 3, 2, 1, 0),
+                                    _mm512_set1_epi32(j));
+        }
+        DSA_TARGET_AVX512 static Reg permute(Reg v, __m512i index) {
+            return _mm512_permutexvar_epi32(index, v);
+        }
+        DSA_TARGET_AVX512 static Mask mask(unsigned bits) { return static_cast<Mask>(bits); }
+        DSA_TARGET_AVX512 static Reg blend(Mask m, Reg a, Reg b) { return _mm512_mask_blend_epi32(m, a, b); }
+        DSA_TARGET_AVX512 static void split(Reg v, Reg pivot, int32_t*& left, int32_t*& right) {
+            Mask less = _mm512_cmplt_epi32_mask(v, pivot);
+            int count = __builtin_popcount(less);
+            _mm512_mask_compressstoreu_epi32(left, less, v);
+            _mm512_mask_compressstoreu_epi32(right - (kLanes - count), Mask(~less), v);
+            left += count;
+            right -= kLanes - count;
+        }
+    };
+    
+    template <>
+    struct Avx512<float> {
+        using Reg = __m512;
+        using Mask = __mmask16;
+        static constexpr int kLanes = 16;
+        
+        DSA_TARGET_AVX512 static Reg load(const float* p) { return _mm512_loadu_ps(p); }
+        DSA_TARGET_AVX512 static void store(float* p, Reg v) { _mm512_storeu_ps(p, v); }
+        DSA_TARGET_AVX512 static Reg set1(float x) { return _mm512_set1_ps(x); }
+        DSA_TARGET_AVX512 static Reg min(Reg a, Reg b) { return _mm512_min_ps(a, b); }
+        DSA_TARGET_AVX512 static Reg max(Reg a, Reg b) { return _mm512_max_ps(a, b); }
+        DSA_TARGET_AVX512 static __m512i xorIndex(int j) { return Avx512<int32_t>::xorIndex(j); }
+        DSA_TARGET_AVX512 static Reg permute(Reg v, __m512i index) {
+            return _mm512_permutexvar_ps(index, v);
+        }
+        DSA_TARGET_AVX512 static Mask mask(unsigned bits) { return static_cast<Mask>(bits); }
+        DSA_TARGET_AVX512 static Reg blend(Mask m, Reg a, Reg b) { return _mm512_mask_blend_ps(m, a, b); }
+        DSA_TARGET_AVX512 static void split(Reg v, Reg pivot, float*& left, float*& right) {
+            Mask less = _mm512_cmp_ps_mask(v, pivot, _CMP_LT_OQ);
+            int count = __builtin_popcount(less);
+            _mm512_mask_compressstoreu_ps(left, less, v);
+            _mm512_mask_compressstoreu_ps(right - (kLanes - count), Mask(~less), v);
+            left += count;
+            right -= kLanes - count;
+        }
+    };
+    
+    template <>
+    struct Avx512<double> {
+        using Reg = __m512d;
+        using Mask = __mmask8;
+        static constexpr int kLanes = 8;
+        
+        DSA_TARGET_AVX512 static Reg load(const double* p) { return _mm512_loadu_pd(p); }
+        DSA_TARGET_AVX512 static void store(double* p, Reg v) { _mm512_storeu_pd(p, v); }
+        DSA_TARGET_AVX512 static Reg set1(double x) { return _mm512_set1_pd(x); }
+        DSA_TARGET_AVX512 static Reg min(Reg a, Reg b) { return _mm512_min_pd(a, b); }
+        DSA_TARGET_AVX512 static Reg max(Reg a, Reg b) { return _mm512_max_pd(a, b); }
+        DSA_TARGET_AVX512 static __m512i xorIndex(int j) {
+            return _mm512_xor_si512(_mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0), _mm512_set1_epi64(j));
+        }
+        DSA_TARGET_AVX512 static Reg permute(Reg v, __m512i index) {
+            return _mm512_permutexvar_pd(index, v);
+        }
+        DSA_TARGET_AVX512 static Mask mask(unsigned bits) { return static_cast<Mask>(bits); }
+        DSA_TARGET_AVX512 static Reg blend(Mask m, Reg a, Reg b) { return _mm512_mask_blend_pd(m, a, b); }
+        DSA_TARGET_AVX512 static void split(Reg v, Reg pivot, double*& left, double*& right) {
+            Mask less = _mm512_cmp_pd_mask(v, pivot, _CMP_LT_OQ);
+            int count = __builtin_popcount(less);
+            _mm512_mask_compressstoreu_pd(left, less, v);
+            _mm512_mask_compressstoreu_pd(right - (kLanes - count), Mask(~less), v);
+            left += count;
+            right -= kLanes - count;
+        }
+    };
+    
+    template <typename T>
+    DSA_TARGET_AVX2 void avx2SortBlock(T* data, size_t n) { detail::sortBlock<Avx2<T>>(data, n); }
+    
+    template <typename T>
+    DSA_TARGET_AVX2 T* avx2Partition(T* first, T* last, T pivot) {
+        return detail::partition<Avx2<T>>(first, last, pivot);
+    }
+    
+    template <typename T>
+    DSA_TARGET_AVX512 void avx512SortBlock(T* data, size_t n) { detail::sortBlock<Avx512<T>>(data, n); }
+    
+    template <typename T>
+    DSA_TARGET_AVX512 T* avx512Partition(T* first, T* last, T pivot) {
+        return detail::partition<Avx512<T>>(first, last, pivot);
+    }
+}
+#endif
+
+#if defined(DSA_SIMD_NEON)
+namespace neon {
+    inline constexpr auto kPartition4x32 = detail::makePartitionTable<4, 4>();
+    inline constexpr auto kPartition2x64 = detail::makePartitionTable<2, 8>();
+    
+    template <typename T> struct Neon;
+    
+    template <>
+    struct Neon<int32_t> {
+        using Reg = int32x4_t;
+        using Mask = uint32x4_t;
+        static constexpr int kLanes = 4;
+        
+        static Reg load(const int32_t* p) { return vld1q_s32(p); }
+        static void store(int32_t* p, Reg v) { vst1q_s32(p, v); }
+        static Reg set1(int32_t x) { return vdupq_n_s32(x); }
+        static Reg min(Reg a, Reg b) { return vminq_s32(a, b); }
+        static Reg max(Reg a, Reg b) { return vmaxq_s32(a, b); }
+        // Byte shuffle indices; each lane is four bytes
+        static uint8x16_t xorIndex(int j) {
+            static const uint8_t iota[16] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+            return veorq_u8(vld1q_u8(iota), vdupq_n_u8(static_cast<uint8_t>(4 * j)));
+        }
+        static Reg permute(Reg v, uint8x16_t index) {
+            return vreinterpretq_s32_u8(vqtbl1q_u8(vreinterpretq_u8_s32(v), index));
+        }
+        static uint32x4_t laneBits() {
+            static const uint32_t bits[4] = {1, 2, 4, 8};
+            return vld1q_u32(bits);
+        }
+        static Mask mask(unsigned bits) { return vtstq_u32(vdupq_n_u32(bits), laneBits()); }
+        static Reg blend(Mask m, Reg a, Reg b) { return vbslq_s32(m, b, a); }
+        static void split(Reg v, Reg pivot, int32_t*& left, int32_t*& right) {
+            unsigned bits = vaddvq_u32(vandq_u32(vcltq_s32(v, pivot), laneBits()));
+            Reg packed = permute(v, vld1q_u8(kPartition4x32[bits].data()));
+            store(left, packed);
+            store(right - kLanes, packed);
+            int count = __builtin_popcount(bits);
+            left += count;
+            right -= kLanes - count;
+        }
+    };
+    
+    template <>
+    struct Neon<float> {
+        using Reg = float32x4_t;
+        using Mask = uint32x4_t;
+        static constexpr int kLanes = 4;
+        
+        static Reg load(const float* p) { return vld1q_f32(p); }
+        static void store(float* p, Reg v) { vst1q_f32(p, v); }
+        static Reg set1(float x) { return vdupq_n_f32(x); }
+        static Reg min(Reg a, Reg b) { return vminq_f32(a, b); }
+        static Reg max(Reg a, Reg b) { return vmaxq_f32(a, b); }
+        static uint8x16_t xorIndex(int j) { return Neon<int32_t>::xorIndex(j); }
+        static Reg permute(Reg v, uint8x16_t index) {
+            return vreinterpretq_f32_u8(vqtbl1q_u8(vreinterpretq_u8_f32(v), index));
+        }
+        static Mask mask(unsigned bits) { return Neon<int32_t>::mask(bits); }
+        static Reg blend(Mask m, Reg a, Reg b) { return vbslq_f32(m, b, a); }
+        static void split(Reg v, Reg pivot, float*& left, float*& right) {
+            unsigned bits = vaddvq_u32(vandq_u32(vcltq_f32(v, pivot), Neon<int32_t>::laneBits()));
+            Reg packed = permute(v, vld1q_u8(kPartition4x32[bits].data()));
+            store(left, packed);
+            store(right - kLanes, packed);
+            int count = __builtin_popcount(bits);
+            left += count;
+            right -= kLanes - count;
+        }
+    };
+    
+    template <>
+    struct Neon<double> {
+        using Reg = float64x2_t;
+        using Mask = uint64x2_t;
+        static constexpr int kLanes = 2;
+        
+        static Reg load(const double* p) { return vld1q_f64(p); }
+        static void store(double* p, Reg v) { vst1q_f64(p, v); }
+        static Reg set1(double x) { return vdupq_n_f64(x); }
+        static Reg min(Reg a, Reg b) { return vminq_f64(a, b); }
+        static Reg max(Reg a, Reg b) { return vmaxq_f64(a, b); }
+        // Only j == 1 occurs with two lanes: swap the halves
+        static int xorIndex(int j) { return j; }
+        static Reg permute(Reg v, int) { return vextq_f64(v, v, 1); }
+        static uint64x2_t laneBits() {
+            static const uint64_t bits[2] = {1, 2};
+            return vld1q_u64(bits);
+        }
+        static Mask mask(unsigned bits) { return vtstq_u64(vdupq_n_u64(bits), laneBits()); }
+        static Reg blend(Mask m, Reg a, Reg b) { return vbslq_f64(m, b, a); }
+        static void split(Reg v, Reg pivot, double*& left, double*& right) {
+            unsigned bits = unsigned(vaddvq_u64(vandq_u64(vcltq_f64(v, pivot), laneBits())));
+            Reg packed = vreinterpretq_f64_u8(vqtbl1q_u8(vreinterpretq_u8_f64(v),
+                                                         vld1q_u8(kPartition2x64[bits].data())));
+            store(left, packed);
+            store(right - kLanes, packed);
+            int count = __builtin_popcount(bits);
+            left += count;
+            right -= kLanes - count;
+        }
+    };
+}
+#endif
+
+// Sort n <= kMaxBlock elements in place. Returns false (leaving the data
+// untouched) when no vector unit is available.
+template <typename T>
+bool sortBlock([[maybe_unused]] T* data, size_t n) {
+    static_assert(isKey<T>, "sortBlock supports int32_t, float and double");
+    if (n < 2) return true;
+    switch (activeIsa()) {
+#if defined(DSA_SIMD_X86)
+        case Isa::Avx512: x86::avx512SortBlock(data, n); return true;
+        case Isa::Avx2: x86::avx2SortBlock(data, n); return true;
+#elif defined(DSA_SIMD_NEON)
+        case Isa::Neon: detail::sortBlock<neon::Neon<T>>(data, n); return true;
+#endif
+        default: return false;
+    }
+}
+
+// Reorder [first, last) so elements < pivot come first; returns the first
+// element that is not less than pivot. Not stable.
+template <typename T>
+T* partition(T* first, T* last, T pivot) {
+    static_assert(isKey<T>, "partition supports int32_t, float and double");
+    switch (activeIsa()) {
+#if defined(DSA_SIMD_X86)
+        case Isa::Avx512: return x86::avx512Partition(first, last, pivot);
+        case Isa::Avx2: return x86::avx2Partition(first, last, pivot);
+#elif defined(DSA_SIMD_NEON)
+        case Isa::Neon: return detail::partition<neon::Neon<T>>(first, last, pivot);
+#endif
+        default: return std::partition(first, last, [pivot](T x) { return x < pivot; });
+    }
+}
+
+} // namespace simd
+} // namespace sort
+} // namespace dsa
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
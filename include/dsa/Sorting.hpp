@@ -6,27 +6,94 @@
  * @author Neel Patel
  * @version 1.0.0
  * 
- * Includes: Bubble, Selection, Insertion, Merge, Quick, Heap Sort
- * All algorithms support custom comparators
+ * Includes: Bubble, Selection, Insertion, Merge (top-down, bottom-up,
+ * natural/TimSort-like), Quick, Heap, Intro Sort, and constexpr sorting
+ * networks for sizes known at compile time (staticSort)
+ * All algorithms support custom comparators and accept iterator pairs,
+ * std::vector, or any random-access range (std::array, std::span, ...)
+ * Intro/Quick Sort of a std::array or C array of up to 32 arithmetic keys
+ * (integers for the stable Insertion Sort) run the sorting network instead
+ * Quick/Intro Sort use SIMD kernels for int32_t/float/double (SimdSort.hpp)
+ * A comparator wrapped in instrument::counted() also reports moves, swaps,
+ * recursion depth and latency (Instrumentation.hpp); instrumented sorts
+ * take the scalar paths
  */
 
 #include <vector>
+#include <array>
 #include <functional>
 #include <algorithm>
 #include <utility>
+#include <iterator>
+#include <cstddef>
+#include <type_traits>
+#include <memory>
+
+#include "Instrumentation.hpp"
+#include "SimdSort.hpp"
 
 namespace dsa {
 namespace sort {
 
+// Shared helpers for the iterator and range overloads
+namespace detail {
+    template <typename It>
+    using IterValue = typename std::iterator_traits<It>::value_type;
+    
+    template <typename Range>
+    using RangeIterator = decltype(std::begin(std::declval<Range&>()));
+    
+    template <typename Range>
+    using RangeValue = IterValue<RangeIterator<Range>>;
+    
+    // Anything with std::begin/std::end: std::array, std::deque, C arrays,
+    // std::span, sub-range views, ...
+    template <typename Range, typename = void>
+    struct is_range : std::false_type {};
+    
+    template <typename Range>
+    struct is_range<Range, std::void_t<RangeIterator<Range>,
+        decltype(std::end(std::declval<Range&>()))>> : std::true_type {};
+    
+    template <typename Range>
+    using EnableIfRange = std::enable_if_t<is_range<Range>::value, int>;
+    
+    // Instrumentation hooks; they compile to nothing unless Compare is an
+    // instrument::Counted
+    template <typename Compare>
+    inline void note(instrument::Counter counter, uint64_t n = 1) {
+        instrument::PolicyFor<Compare>::count(counter, n);
+    }
+    
+    template <typename Compare>
+    using DepthScope = instrument::DepthScope<instrument::PolicyFor<Compare>>;
+    
+    template <typename Compare>
+    using SortTimer = instrument::Timer<instrument::PolicyFor<Compare>>;
+    
+    // Arithmetic keys with std::less/std::greater: a comparison is a single
+    // instruction, so the partition and merge loops use conditional moves
+    // instead of branching on every result
+    template <typename T, typename Compare>
+    constexpr bool isBranchless = std::is_arithmetic_v<T> &&
+        (std::is_same_v<Compare, std::less<T>> || std::is_same_v<Compare, std::less<>> ||
+         std::is_same_v<Compare, std::greater<T>> || std::is_same_v<Compare, std::greater<>>);
+}
+
+// Every algorithm comes in three forms: a random-access iterator pair
+// (sorts in place, no copies), a std::vector wrapper, and a generic range
+
 // Bubble Sort - O(n^2)
-template <typename T, typename Compare = std::less<T>>
-void bubbleSort(std::vector<T>& arr, Compare comp = Compare()) {
-    size_t n = arr.size();
-    for (size_t i = 0; i < n - 1; ++i) {
+template <typename RandomIt, typename Compare = std::less<detail::IterValue<RandomIt>>>
+void bubbleSort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    detail::SortTimer<Compare> timer(instrument::Operation::Sort);
+    std::ptrdiff_t n = last - first;
+    for (std::ptrdiff_t i = 0; i < n - 1; ++i) {
         bool swapped = false;
-        for (size_t j = 0; j < n - i - 1; ++j) {
-            if (comp(arr[j + 1], arr[j])) {
-                std::swap(arr[j], arr[j + 1]);
+        for (std::ptrdiff_t j = 0; j < n - i - 1; ++j) {
+            if (comp(first[j + 1], first[j])) {
+                std::iter_swap(first + j, first + j + 1);
+                detail::note<Compare>(instrument::Counter::Swaps);
                 swapped = true;
             }
         }
@@ -34,142 +101,1064 @@ void bubbleSort(std::vector<T>& arr, Compare comp = Compare()) {
     }
 }
 
-// Selection Sort - O(n^2)
 template <typename T, typename Compare = std::less<T>>
-void selectionSort(std::vector<T>& arr, Compare comp = Compare()) {
-    size_t n = arr.size();
-    for (size_t i = 0; i < n - 1; ++i) {
-        size_t minIdx = i;
-        for (size_t j = i + 1; j < n; ++j) {
-            if (comp(arr[j], arr[minIdx])) minIdx = j;
+void bubbleSort(std::vector<T>& arr, Compare comp = Compare()) {
+    bubbleSort(arr.begin(), arr.end(), comp);
+}
+
+template <typename Range, detail::EnableIfRange<Range> = 0,
+          typename Compare = std::less<detail::RangeValue<Range>>>
+void bubbleSort(Range&& range, Compare comp = Compare()) {
+    bubbleSort(std::begin(range), std::end(range), comp);
+}
+
+// Selection Sort - O(n^2)
+template <typename RandomIt, typename Compare = std::less<detail::IterValue<RandomIt>>>
+void selectionSort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    detail::SortTimer<Compare> timer(instrument::Operation::Sort);
+    for (RandomIt i = first; i != last; ++i) {
+        RandomIt minIt = i;
+        for (RandomIt j = i + 1; j != last; ++j) {
+            if (comp(*j, *minIt)) minIt = j;
+        }
+        if (minIt != i) {
+            std::iter_swap(i, minIt);
+            detail::note<Compare>(instrument::Counter::Swaps);
         }
-        if (minIdx != i) std::swap(arr[i], arr[minIdx]);
     }
 }
 
-// Insertion Sort - O(n^2), good for small/nearly sorted arrays
 template <typename T, typename Compare = std::less<T>>
-void insertionSort(std::vector<T>& arr, Compare comp = Compare()) {
-    for (size_t i = 1; i < arr.size(); ++i) {
-        T key = arr[i];
-        int j = static_cast<int>(i) - 1;
-        while (j >= 0 && comp(key, arr[j])) {
-            arr[j + 1] = arr[j];
-            --j;
-        }
-        arr[j + 1] = key;
-    }
+void selectionSort(std::vector<T>& arr, Compare comp = Compare()) {
+    selectionSort(arr.begin(), arr.end(), comp);
 }
 
-// Merge Sort - O(n log n)
+template <typename Range, detail::EnableIfRange<Range> = 0,
+          typename Compare = std::less<detail::RangeValue<Range>>>
+void selectionSort(Range&& range, Compare comp = Compare()) {
+    selectionSort(std::begin(range), std::end(range), comp);
+}
+
+// Static Sort - sorting networks for sizes known at compile time
 namespace detail {
+    struct NetworkComparator {
+        size_t lo;
+        size_t hi;
+    };
+    
+    // Smallest networks known for 9, 10, 12 and 16 inputs (optimal up to
+    // 12; Green's 60 for 16)
+    inline constexpr NetworkComparator kNetwork9[] = {
+        {0, 3}, {1, 7}, {2, 5}, {4, 8}, {0, 7}, {2, 4}, {3, 8}, {5, 6}, {0, 2}, {1, 3}, {4, 5},
+        {7, 8}, {1, 4}, {3, 6}, {5, 7}, {0, 1}, {2, 4}, {3, 5}, {6, 8}, {2, 3}, {4, 5}, {6, 7},
+        {1, 2}, {3, 4}, {5, 6},
+    };
+    
+    inline constexpr NetworkComparator kNetwork10[] = {
+        {0, 8}, {1, 9}, {2, 7}, {3, 5}, {4, 6}, {0, 2}, {1, 4}, {5, 8}, {7, 9}, {0, 3}, {2, 4},
+        {5, 7}, {6, 9}, {0, 1}, {3, 6}, {8, 9}, {1, 5}, {2, 3}, {4, 8}, {6, 7}, {1, 2}, {3, 5},
+        {4, 6}, {7, 8}, {2, 3}, {4, 5}, {6, 7}, {3, 4}, {5, 6},
+    };
+    
+    inline constexpr NetworkComparator kNetwork12[] = {
+        {0, 8}, {1, 7}, {2, 6}, {3, 11}, {4, 10}, {5, 9}, {0, 1}, {2, 5}, {3, 4}, {6, 9},
+        {7, 8}, {10, 11}, {0, 2}, {1, 6}, {5, 10}, {9, 11}, {0, 3}, {1, 2}, {4, 6}, {5, 7},
+        {8, 11}, {9, 10}, {1, 4}, {3, 5}, {6, 8}, {7, 10}, {1, 3}, {2, 5}, {6, 9}, {8, 10},
+        {2, 3}, {4, 5}, {6, 7}, {8, 9}, {4, 6}, {5, 7}, {3, 4}, {5, 6}, {7, 8},
+    };
+    
+    inline constexpr NetworkComparator kNetwork16[] = {
+        {0, 13}, {1, 12}, {2, 15}, {3, 14}, {4, 8}, {5, 6}, {7, 11}, {9, 10}, {0, 5}, {1, 7},
+        {2, 9}, {3, 4}, {6, 13}, {8, 14}, {10, 15}, {11, 12}, {0, 1}, {2, 3}, {4, 5}, {6, 8},
+        {7, 9}, {10, 11}, {12, 13}, {14, 15}, {0, 2}, {1, 3}, {4, 10}, {5, 11}, {6, 7}, {8, 9},
+        {12, 14}, {13, 15}, {1, 2}, {3, 12}, {4, 6}, {5, 7}, {8, 10}, {9, 11}, {13, 14}, {1, 4},
+        {2, 6}, {5, 8}, {7, 10}, {9, 13}, {11, 14}, {2, 4}, {3, 6}, {9, 12}, {11, 13}, {3, 5},
+        {6, 8}, {7, 9}, {10, 12}, {3, 4}, {5, 6}, {7, 8}, {9, 10}, {11, 12}, {6, 7}, {8, 9},
+    };
+    
+    // The network writers append comparators shifted by offset to out
+    // (when not null) and return the new count, so one pass sizes the
+    // array and a second fills it
+    
+    // First n inputs of a larger network; the dropped inputs act as +inf
+    template <size_t M>
+    constexpr size_t emitTable(const NetworkComparator (&table)[M], size_t n, size_t offset,
+                               NetworkComparator* out, size_t count) {
+        for (const NetworkComparator& c : table) {
+            if (c.hi >= n) continue;
+            if (out) out[count] = NetworkComparator{offset + c.lo, offset + c.hi};
+            ++count;
+        }
+        return count;
+    }
+    
+    // Batcher's odd-even merge sort on n inputs from merge stage firstStage
+    // on (1 sorts from scratch; p merges sorted blocks of p)
+    constexpr size_t emitOddEvenMerge(size_t n, size_t firstStage, size_t offset,
+                                      NetworkComparator* out, size_t count) {
+        for (size_t p = firstStage; p < n; p *= 2) {
+            for (size_t k = p; k >= 1; k /= 2) {
+                for (size_t j = k % p; j + k < n; j += 2 * k) {
+                    for (size_t i = 0; i < k && i + j + k < n; ++i) {
+                        if ((i + j) / (2 * p) != (i + j + k) / (2 * p)) continue;
+                        if (out) out[count] = NetworkComparator{offset + i + j, offset + i + j + k};
+                        ++count;
+                    }
+                }
+            }
+        }
+        return count;
+    }
+    
+    // Batcher is size-optimal up to 8 inputs and the tables up to 16
+    // (except 46 for 13, one over the best known). Beyond, the two halves
+    // below and above the largest power of two p < n are sorted
+    // recursively and merged by Batcher's stage p: 185 comparators for
+    // 32, matching the best known.
+    constexpr size_t emitNetwork(size_t n, size_t offset, NetworkComparator* out, size_t count) {
+        if (n <= 8) return emitOddEvenMerge(n, 1, offset, out, count);
+        if (n == 9) return emitTable(kNetwork9, n, offset, out, count);
+        if (n == 10) return emitTable(kNetwork10, n, offset, out, count);
+        if (n <= 12) return emitTable(kNetwork12, n, offset, out, count);
+        if (n <= 16) return emitTable(kNetwork16, n, offset, out, count);
+        size_t p = 16;
+        while (2 * p < n) p *= 2;
+        count = emitNetwork(p, offset, out, count);
+        count = emitNetwork(n - p, offset + p, out, count);
+        return emitOddEvenMerge(n, p, offset, out, count);
+    }
+    
+    template <size_t N>
+    constexpr auto makeNetwork() {
+        std::array<NetworkComparator, emitNetwork(N, 0, nullptr, 0)> network{};
+        emitNetwork(N, 0, network.data(), 0);
+        return network;
+    }
+    
+    template <size_t N>
+    inline constexpr auto kSortingNetwork = makeNetwork<N>();
+    
     template <typename T, typename Compare>
-    void merge(std::vector<T>& arr, int left, int mid, int right, Compare comp) {
-        std::vector<T> temp(right - left + 1);
-        int i = left, j = mid + 1, k = 0;
-        
-        while (i <= mid && j <= right) {
-            temp[k++] = comp(arr[i], arr[j]) ? arr[i++] : arr[j++];
+    constexpr void compareExchange(T& a, T& b, Compare& comp) {
+        if constexpr (isBranchless<T, Compare>) {
+            // Spelled as min/max so floating point gets minsd/maxsd. On a tie
+            // (0.0/-0.0, NaN) both selects keep their own input, so like the
+            // SIMD kernels every value survives
+            T x = a;
+            T y = b;
+            a = comp(y, x) ? y : x;
+            b = comp(y, x) ? x : y;
+        } else if (comp(b, a)) {
+            T tmp = std::move(a);
+            a = std::move(b);
+            b = std::move(tmp);
+            if constexpr (instrument::PolicyFor<Compare>::enabled) note<Compare>(instrument::Counter::Swaps);
         }
-        while (i <= mid) temp[k++] = arr[i++];
-        while (j <= right) temp[k++] = arr[j++];
-        
-        for (int p = 0; p < k; ++p) arr[left + p] = temp[p];
     }
     
+    // One fold over the comparators: every index is a constant, so the
+    // network unrolls completely (into registers for arithmetic keys)
+    template <size_t N, typename RandomIt, typename Compare, size_t... I>
+    constexpr void applyNetwork(RandomIt first, Compare& comp, std::index_sequence<I...>) {
+        (compareExchange(first[kSortingNetwork<N>[I].lo], first[kSortingNetwork<N>[I].hi], comp), ...);
+    }
+    
+    // Largest fixed size the range overloads hand to staticSort
+    inline constexpr size_t kStaticSortMaxSize = 32;
+    
+    // Compile-time size of std::array and C arrays, 0 for other ranges
+    template <typename Range>
+    struct StaticExtent : std::integral_constant<size_t, 0> {};
+    
+    template <typename T, size_t N>
+    struct StaticExtent<std::array<T, N>> : std::integral_constant<size_t, N> {};
+    
+    template <typename T, size_t N>
+    struct StaticExtent<T[N]> : std::integral_constant<size_t, N> {};
+    
+    template <typename Range>
+    inline constexpr size_t staticExtent = StaticExtent<std::remove_cv_t<std::remove_reference_t<Range>>>::value;
+    
+    template <typename Range>
+    inline constexpr bool hasSmallStaticExtent = staticExtent<Range> >= 2 && staticExtent<Range> <= kStaticSortMaxSize;
+    
+    // Networks are not stable; a stable sort may use one only where equal
+    // keys cannot be told apart
     template <typename T, typename Compare>
-    void mergeSort(std::vector<T>& arr, int left, int right, Compare comp) {
-        if (left < right) {
-            int mid = left + (right - left) / 2;
-            mergeSort(arr, left, mid, comp);
-            mergeSort(arr, mid + 1, right, comp);
-            merge(arr, left, mid, right, comp);
+    inline constexpr bool equalMeansIdentical = std::is_integral_v<T> && isBranchless<T, Compare>;
+}
+
+// Sort first[0, N) with a fixed sorting network; usable in constant
+// expressions. Not stable. Meant for small N (the networks grow as
+// N log^2 N and are fully unrolled).
+template <size_t N, typename RandomIt, typename Compare = std::less<detail::IterValue<RandomIt>>>
+constexpr void staticSort(RandomIt first, Compare comp = Compare()) {
+    detail::SortTimer<Compare> timer(instrument::Operation::Sort);
+    if constexpr (N >= 2) {
+        detail::applyNetwork<N>(first, comp, std::make_index_sequence<detail::kSortingNetwork<N>.size()>());
+    }
+}
+
+template <size_t N, typename T, typename Compare = std::less<T>>
+constexpr void staticSort(std::array<T, N>& arr, Compare comp = Compare()) {
+    staticSort<N>(arr.begin(), comp);
+}
+
+template <typename T, size_t N, typename Compare = std::less<T>>
+constexpr void staticSort(T (&arr)[N], Compare comp = Compare()) {
+    staticSort<N>(&arr[0], comp);
+}
+
+// Insertion Sort - O(n^2), good for small/nearly sorted arrays
+namespace detail {
+    template <typename RandomIt, typename Compare>
+    void insertionSort(RandomIt first, RandomIt last, Compare comp) {
+        if (first == last) return;
+        for (RandomIt cur = first + 1; cur != last; ++cur) {
+            RandomIt sift = cur;
+            RandomIt prev = cur - 1;
+            if (comp(*sift, *prev)) {
+                auto tmp = std::move(*sift);
+                do {
+                    *sift-- = std::move(*prev);
+                } while (sift != first && comp(tmp, *--prev));
+                *sift = std::move(tmp);
+                note<Compare>(instrument::Counter::Moves, static_cast<uint64_t>(cur - sift) + 2);
+            }
         }
     }
 }
 
+template <typename RandomIt, typename Compare = std::less<detail::IterValue<RandomIt>>>
+void insertionSort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    detail::SortTimer<Compare> timer(instrument::Operation::Sort);
+    detail::insertionSort(first, last, comp);
+}
+
 template <typename T, typename Compare = std::less<T>>
-void mergeSort(std::vector<T>& arr, Compare comp = Compare()) {
-    if (arr.size() > 1) {
-        detail::mergeSort(arr, 0, static_cast<int>(arr.size()) - 1, comp);
+void insertionSort(std::vector<T>& arr, Compare comp = Compare()) {
+    insertionSort(arr.begin(), arr.end(), comp);
+}
+
+// Small fixed-size arrays of integers take the sorting network
+template <typename Range, detail::EnableIfRange<Range> = 0,
+          typename Compare = std::less<detail::RangeValue<Range>>>
+void insertionSort(Range&& range, Compare comp = Compare()) {
+    if constexpr (detail::hasSmallStaticExtent<Range> &&
+                  detail::equalMeansIdentical<detail::RangeValue<Range>, Compare>) {
+        staticSort<detail::staticExtent<Range>>(std::begin(range), comp);
+    } else {
+        insertionSort(std::begin(range), std::end(range), comp);
     }
 }
 
-// Quick Sort - O(n log n) average, O(n^2) worst
+// Merge Sort - O(n log n), stable, one scratch allocation per sort
+
+// Reusable scratch space for the merge sorts. Holds raw storage only, so
+// T need not be default-constructible; elements are moved in and out.
+template <typename T>
+class MergeBuffer {
+public:
+    MergeBuffer() = default;
+    explicit MergeBuffer(size_t capacity) { reserve(capacity); }
+    
+    MergeBuffer(const MergeBuffer&) = delete;
+    MergeBuffer& operator=(const MergeBuffer&) = delete;
+    
+    MergeBuffer(MergeBuffer&& other) noexcept
+        : data_(other.data_), capacity_(other.capacity_) {
+        other.data_ = nullptr;
+        other.capacity_ = 0;
+    }
+    
+    MergeBuffer& operator=(MergeBuffer&& other) noexcept {
+        if (this != &other) {
+            release();
+            data_ = other.data_;
+            capacity_ = other.capacity_;
+            other.data_ = nullptr;
+            other.capacity_ = 0;
+        }
+        return *this;
+    }
+    
+    ~MergeBuffer() { release(); }
+    
+    // Sorting n elements needs room for n / 2
+    void reserve(size_t capacity) {
+        if (capacity <= capacity_) return;
+        release();
+        data_ = std::allocator<T>().allocate(capacity);
+        capacity_ = capacity;
+    }
+    
+    [[nodiscard]] T* data() const { return data_; }
+    [[nodiscard]] size_t capacity() const { return capacity_; }
+    
+private:
+    void release() {
+        if (data_) std::allocator<T>().deallocate(data_, capacity_);
+        data_ = nullptr;
+        capacity_ = 0;
+    }
+    
+    T* data_ = nullptr;
+    size_t capacity_ = 0;
+};
+
 namespace detail {
-    template <typename T, typename Compare>
-    int partition(std::vector<T>& arr, int low, int high, Compare comp) {
-        T pivot = arr[high];
-        int i = low - 1;
-        for (int j = low; j < high; ++j) {
-            if (comp(arr[j], pivot)) {
-                ++i;
-                std::swap(arr[i], arr[j]);
+    constexpr std::ptrdiff_t kMergeInsertionThreshold = 16;
+    
+    // Stable merge of the sorted runs [first, mid) and [mid, last). Only the
+    // shorter run is moved into the buffer, so it needs min(left, right) slots.
+    template <typename RandomIt, typename T, typename Compare>
+    void merge(RandomIt first, RandomIt mid, RandomIt last, T* buffer, Compare comp) {
+        if (first == mid || mid == last || !comp(*mid, *(mid - 1))) return;
+        
+        // Elements already in their final place need not move
+        first = std::upper_bound(first, mid, *mid, comp);
+        last = std::lower_bound(mid, last, *(mid - 1), comp);
+        
+        if (mid - first <= last - mid) {
+            T* bufEnd = std::uninitialized_move(first, mid, buffer);
+            T* b = buffer;
+            RandomIt j = mid;
+            RandomIt out = first;
+            if constexpr (isBranchless<T, Compare>) {
+                while (b != bufEnd && j != last) {
+                    bool takeRight = comp(*j, *b);
+                    *out++ = takeRight ? *j : *b;
+                    j += takeRight;
+                    b += !takeRight;
+                }
+            } else {
+                while (b != bufEnd && j != last) {
+                    if (comp(*j, *b)) *out++ = std::move(*j++);
+                    else *out++ = std::move(*b++);
+                }
             }
+            RandomIt outEnd = std::move(b, bufEnd, out);
+            std::destroy(buffer, bufEnd);
+            note<Compare>(instrument::Counter::Moves, static_cast<uint64_t>((bufEnd - buffer) + (outEnd - first)));
+        } else {
+            T* bufEnd = std::uninitialized_move(mid, last, buffer);
+            T* b = bufEnd;
+            RandomIt i = mid;
+            RandomIt out = last;
+            if constexpr (isBranchless<T, Compare>) {
+                while (b != buffer && i != first) {
+                    bool takeLeft = comp(*(b - 1), *(i - 1));
+                    *--out = takeLeft ? *(i - 1) : *(b - 1);
+                    i -= takeLeft;
+                    b -= !takeLeft;
+                }
+            } else {
+                while (b != buffer && i != first) {
+                    if (comp(*(b - 1), *(i - 1))) *--out = std::move(*--i);
+                    else *--out = std::move(*--b);
+                }
+            }
+            RandomIt outBegin = std::move_backward(buffer, b, out);
+            std::destroy(buffer, bufEnd);
+            note<Compare>(instrument::Counter::Moves, static_cast<uint64_t>((bufEnd - buffer) + (last - outBegin)));
         }
-        std::swap(arr[i + 1], arr[high]);
-        return i + 1;
     }
     
-    template <typename T, typename Compare>
-    void quickSort(std::vector<T>& arr, int low, int high, Compare comp) {
-        if (low < high) {
-            int pi = partition(arr, low, high, comp);
-            quickSort(arr, low, pi - 1, comp);
-            quickSort(arr, pi + 1, high, comp);
+    template <typename RandomIt, typename T, typename Compare>
+    void mergeSort(RandomIt first, RandomIt last, T* buffer, Compare comp) {
+        DepthScope<Compare> depth;
+        if (last - first <= kMergeInsertionThreshold) {
+            detail::insertionSort(first, last, comp);
+            return;
+        }
+        RandomIt mid = first + (last - first) / 2;
+        detail::mergeSort(first, mid, buffer, comp);
+        detail::mergeSort(mid, last, buffer, comp);
+        detail::merge(first, mid, last, buffer, comp);
+    }
+    
+    template <typename RandomIt, typename T, typename Compare>
+    void bottomUpMergeSort(RandomIt first, RandomIt last, T* buffer, Compare comp) {
+        std::ptrdiff_t n = last - first;
+        for (std::ptrdiff_t lo = 0; lo < n; lo += kMergeInsertionThreshold) {
+            detail::insertionSort(first + lo, first + std::min(lo + kMergeInsertionThreshold, n), comp);
+        }
+        for (std::ptrdiff_t width = kMergeInsertionThreshold; width < n; width *= 2) {
+            for (std::ptrdiff_t lo = 0; lo < n - width; lo += 2 * width) {
+                detail::merge(first + lo, first + lo + width,
+                      first + std::min(lo + 2 * width, n), buffer, comp);
+            }
+        }
+    }
+    
+    // Find the run starting at `first`; strictly descending runs are
+    // reversed in place (strictness keeps the sort stable)
+    template <typename RandomIt, typename Compare>
+    RandomIt makeAscendingRun(RandomIt first, RandomIt last, Compare comp) {
+        RandomIt runEnd = first + 1;
+        if (runEnd == last) return last;
+        if (comp(*runEnd, *first)) {
+            while (++runEnd != last && comp(*runEnd, *(runEnd - 1)));
+            std::reverse(first, runEnd);
+        } else {
+            while (++runEnd != last && !comp(*runEnd, *(runEnd - 1)));
+        }
+        return runEnd;
+    }
+    
+    // Minimum run length in [16, 32] such that n / minRun is close to a power of 2
+    inline std::ptrdiff_t minRunLength(std::ptrdiff_t n) {
+        std::ptrdiff_t low = 0;
+        while (n >= 2 * kMergeInsertionThreshold) {
+            low |= n & 1;
+            n >>= 1;
+        }
+        return n + low;
+    }
+    
+    // TimSort-style natural merge sort: O(n) on presorted input, O(n log n)
+    // worst case
+    template <typename RandomIt, typename T, typename Compare>
+    void naturalMergeSort(RandomIt first, RandomIt last, T* buffer, Compare comp) {
+        std::ptrdiff_t n = last - first;
+        if (n < 2) return;
+        std::ptrdiff_t minRun = minRunLength(n);
+        
+        // Pending runs; the stack invariants bound its depth by log_phi(n)
+        struct Run { RandomIt start; std::ptrdiff_t length; };
+        Run runs[90];
+        int count = 0;
+        
+        auto mergeAt = [&](int i) {
+            detail::merge(runs[i].start, runs[i + 1].start,
+                  runs[i + 1].start + runs[i + 1].length, buffer, comp);
+            runs[i].length += runs[i + 1].length;
+            for (int k = i + 1; k + 1 < count; ++k) runs[k] = runs[k + 1];
+            --count;
+        };
+        
+        for (RandomIt cur = first; cur != last;) {
+            RandomIt runEnd = makeAscendingRun(cur, last, comp);
+            if (runEnd - cur < minRun) {
+                RandomIt forced = cur + std::min(minRun, last - cur);
+                detail::insertionSort(cur, forced, comp);
+                runEnd = forced;
+            }
+            runs[count++] = {cur, runEnd - cur};
+            cur = runEnd;
+            
+            // Keep run lengths growing faster than Fibonacci from the top down
+            while (count > 1) {
+                int i = count - 2;
+                if ((i > 0 && runs[i - 1].length <= runs[i].length + runs[i + 1].length) ||
+                    (i > 1 && runs[i - 2].length <= runs[i - 1].length + runs[i].length)) {
+                    if (runs[i - 1].length < runs[i + 1].length) --i;
+                } else if (runs[i].length > runs[i + 1].length) {
+                    break;
+                }
+                mergeAt(i);
+            }
+        }
+        while (count > 1) {
+            int i = count - 2;
+            if (i > 0 && runs[i - 1].length < runs[i + 1].length) --i;
+            mergeAt(i);
         }
     }
 }
 
+template <typename RandomIt, typename Compare = std::less<detail::IterValue<RandomIt>>>
+void mergeSort(RandomIt first, RandomIt last, MergeBuffer<detail::IterValue<RandomIt>>& buffer,
+               Compare comp = Compare()) {
+    detail::SortTimer<Compare> timer(instrument::Operation::Sort);
+    if (last - first < 2) return;
+    buffer.reserve((last - first) / 2);
+    detail::mergeSort(first, last, buffer.data(), comp);
+}
+
+template <typename RandomIt, typename Compare = std::less<detail::IterValue<RandomIt>>>
+void mergeSort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    MergeBuffer<detail::IterValue<RandomIt>> buffer;
+    mergeSort(first, last, buffer, comp);
+}
+
 template <typename T, typename Compare = std::less<T>>
-void quickSort(std::vector<T>& arr, Compare comp = Compare()) {
-    if (arr.size() > 1) {
-        detail::quickSort(arr, 0, static_cast<int>(arr.size()) - 1, comp);
-    }
+void mergeSort(std::vector<T>& arr, MergeBuffer<T>& buffer, Compare comp = Compare()) {
+    mergeSort(arr.begin(), arr.end(), buffer, comp);
+}
+
+template <typename T, typename Compare = std::less<T>>
+void mergeSort(std::vector<T>& arr, Compare comp = Compare()) {
+    mergeSort(arr.begin(), arr.end(), comp);
+}
+
+template <typename Range, detail::EnableIfRange<Range> = 0,
+          typename Compare = std::less<detail::RangeValue<Range>>>
+void mergeSort(Range&& range, Compare comp = Compare()) {
+    mergeSort(std::begin(range), std::end(range), comp);
+}
+
+// Bottom-up Merge Sort - O(n log n), stable, no recursion
+template <typename RandomIt, typename Compare = std::less<detail::IterValue<RandomIt>>>
+void bottomUpMergeSort(RandomIt first, RandomIt last,
+                       MergeBuffer<detail::IterValue<RandomIt>>& buffer,
+                       Compare comp = Compare()) {
+    detail::SortTimer<Compare> timer(instrument::Operation::Sort);
+    if (last - first < 2) return;
+    buffer.reserve((last - first) / 2);
+    detail::bottomUpMergeSort(first, last, buffer.data(), comp);
+}
+
+template <typename RandomIt, typename Compare = std::less<detail::IterValue<RandomIt>>>
+void bottomUpMergeSort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    MergeBuffer<detail::IterValue<RandomIt>> buffer;
+    bottomUpMergeSort(first, last, buffer, comp);
+}
+
+template <typename T, typename Compare = std::less<T>>
+void bottomUpMergeSort(std::vector<T>& arr, MergeBuffer<T>& buffer, Compare comp = Compare()) {
+    bottomUpMergeSort(arr.begin(), arr.end(), buffer, comp);
+}
+
+template <typename T, typename Compare = std::less<T>>
+void bottomUpMergeSort(std::vector<T>& arr, Compare comp = Compare()) {
+    bottomUpMergeSort(arr.begin(), arr.end(), comp);
+}
+
+template <typename Range, detail::EnableIfRange<Range> = 0,
+          typename Compare = std::less<detail::RangeValue<Range>>>
+void bottomUpMergeSort(Range&& range, Compare comp = Compare()) {
+    bottomUpMergeSort(std::begin(range), std::end(range), comp);
+}
+
+// Natural Merge Sort (TimSort-like) - O(n) best on presorted runs, O(n log n) worst, stable
+template <typename RandomIt, typename Compare = std::less<detail::IterValue<RandomIt>>>
+void naturalMergeSort(RandomIt first, RandomIt last,
+                      MergeBuffer<detail::IterValue<RandomIt>>& buffer,
+                      Compare comp = Compare()) {
+    detail::SortTimer<Compare> timer(instrument::Operation::Sort);
+    if (last - first < 2) return;
+    buffer.reserve((last - first) / 2);
+    detail::naturalMergeSort(first, last, buffer.data(), comp);
+}
+
+template <typename RandomIt, typename Compare = std::less<detail::IterValue<RandomIt>>>
+void naturalMergeSort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    MergeBuffer<detail::IterValue<RandomIt>> buffer;
+    naturalMergeSort(first, last, buffer, comp);
+}
+
+template <typename T, typename Compare = std::less<T>>
+void naturalMergeSort(std::vector<T>& arr, MergeBuffer<T>& buffer, Compare comp = Compare()) {
+    naturalMergeSort(arr.begin(), arr.end(), buffer, comp);
+}
+
+template <typename T, typename Compare = std::less<T>>
+void naturalMergeSort(std::vector<T>& arr, Compare comp = Compare()) {
+    naturalMergeSort(arr.begin(), arr.end(), comp);
+}
+
+template <typename Range, detail::EnableIfRange<Range> = 0,
+          typename Compare = std::less<detail::RangeValue<Range>>>
+void naturalMergeSort(Range&& range, Compare comp = Compare()) {
+    naturalMergeSort(std::begin(range), std::end(range), comp);
 }
 
 // Heap Sort - O(n log n)
 namespace detail {
-    template <typename T, typename Compare>
-    void heapify(std::vector<T>& arr, int n, int i, Compare comp) {
-        int largest = i;
-        int left = 2 * i + 1;
-        int right = 2 * i + 2;
+    // Sift the element at index i down a max-heap of n elements
+    template <typename RandomIt, typename Compare>
+    void heapify(RandomIt first, std::ptrdiff_t n, std::ptrdiff_t i, Compare comp) {
+        while (true) {
+            std::ptrdiff_t largest = i;
+            std::ptrdiff_t left = 2 * i + 1;
+            std::ptrdiff_t right = 2 * i + 2;
+            
+            if (left < n && comp(first[largest], first[left])) largest = left;
+            if (right < n && comp(first[largest], first[right])) largest = right;
+            if (largest == i) return;
+            
+            std::iter_swap(first + i, first + largest);
+            note<Compare>(instrument::Counter::Swaps);
+            i = largest;
+        }
+    }
+    
+    template <typename RandomIt, typename Compare>
+    void heapSort(RandomIt first, RandomIt last, Compare comp) {
+        std::ptrdiff_t n = last - first;
         
-        if (left < n && comp(arr[largest], arr[left])) largest = left;
-        if (right < n && comp(arr[largest], arr[right])) largest = right;
+        // Build heap
+        for (std::ptrdiff_t i = n / 2 - 1; i >= 0; --i) {
+            heapify(first, n, i, comp);
+        }
         
-        if (largest != i) {
-            std::swap(arr[i], arr[largest]);
-            heapify(arr, n, largest, comp);
+        // Extract elements
+        for (std::ptrdiff_t i = n - 1; i > 0; --i) {
+            std::iter_swap(first, first + i);
+            note<Compare>(instrument::Counter::Swaps);
+            heapify(first, i, 0, comp);
         }
     }
 }
 
+template <typename RandomIt, typename Compare = std::less<detail::IterValue<RandomIt>>>
+void heapSort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    detail::SortTimer<Compare> timer(instrument::Operation::Sort);
+    detail::heapSort(first, last, comp);
+}
+
 template <typename T, typename Compare = std::less<T>>
 void heapSort(std::vector<T>& arr, Compare comp = Compare()) {
-    int n = static_cast<int>(arr.size());
+    heapSort(arr.begin(), arr.end(), comp);
+}
+
+template <typename Range, detail::EnableIfRange<Range> = 0,
+          typename Compare = std::less<detail::RangeValue<Range>>>
+void heapSort(Range&& range, Compare comp = Compare()) {
+    heapSort(std::begin(range), std::end(range), comp);
+}
+
+// Intro Sort - O(n log n) worst case (pattern-defeating quicksort engine)
+namespace detail {
+    constexpr std::ptrdiff_t kInsertionSortThreshold = 24;
+    constexpr std::ptrdiff_t kNintherThreshold = 128;
+    constexpr std::ptrdiff_t kPartialInsertionSortLimit = 8;
+    
+    // Insertion sort that relies on *(first - 1) being <= every element
+    template <typename RandomIt, typename Compare>
+    void unguardedInsertionSort(RandomIt first, RandomIt last, Compare comp) {
+        if (first == last) return;
+        for (RandomIt cur = first + 1; cur != last; ++cur) {
+            RandomIt sift = cur;
+            RandomIt prev = cur - 1;
+            if (comp(*sift, *prev)) {
+                auto tmp = std::move(*sift);
+                do {
+                    *sift-- = std::move(*prev);
+                } while (comp(tmp, *--prev));
+                *sift = std::move(tmp);
+                note<Compare>(instrument::Counter::Moves, static_cast<uint64_t>(cur - sift) + 2);
+            }
+        }
+    }
+    
+    // Insertion sort that gives up after a few element moves; returns
+    // true if the range ended up sorted
+    template <typename RandomIt, typename Compare>
+    bool partialInsertionSort(RandomIt first, RandomIt last, Compare comp) {
+        if (first == last) return true;
+        std::ptrdiff_t moves = 0;
+        for (RandomIt cur = first + 1; cur != last; ++cur) {
+            RandomIt sift = cur;
+            RandomIt prev = cur - 1;
+            if (comp(*sift, *prev)) {
+                auto tmp = std::move(*sift);
+                do {
+                    *sift-- = std::move(*prev);
+                } while (sift != first && comp(tmp, *--prev));
+                *sift = std::move(tmp);
+                moves += cur - sift;
+                note<Compare>(instrument::Counter::Moves, static_cast<uint64_t>(cur - sift) + 2);
+            }
+            if (moves > kPartialInsertionSortLimit) return false;
+        }
+        return true;
+    }
+    
+    template <typename RandomIt, typename Compare>
+    void sort2(RandomIt a, RandomIt b, Compare& comp) {
+        if (comp(*b, *a)) {
+            std::iter_swap(a, b);
+            note<Compare>(instrument::Counter::Swaps);
+        }
+    }
+    
+    // Order *a <= *b <= *c
+    template <typename RandomIt, typename Compare>
+    void sort3(RandomIt a, RandomIt b, RandomIt c, Compare& comp) {
+        sort2(a, b, comp);
+        sort2(b, c, comp);
+        sort2(a, b, comp);
+    }
     
-    // Build heap
-    for (int i = n / 2 - 1; i >= 0; --i) {
-        detail::heapify(arr, n, i, comp);
+    constexpr size_t kPartitionBlockSize = 64;
+    
+    // Swap num misplaced pairs found by partitionRightBranchless. A cyclic
+    // permutation needs fewer moves than swaps; real swaps are kept when both
+    // blocks are full, so descending input stays linear.
+    template <typename RandomIt>
+    void swapOffsets(RandomIt leftBase, RandomIt rightBase, const unsigned char* leftOffsets,
+                     const unsigned char* rightOffsets, size_t num, bool useSwaps) {
+        if (useSwaps) {
+            for (size_t i = 0; i < num; ++i) {
+                std::iter_swap(leftBase + leftOffsets[i], rightBase - rightOffsets[i]);
+            }
+        } else if (num > 0) {
+            RandomIt l = leftBase + leftOffsets[0];
+            RandomIt r = rightBase - rightOffsets[0];
+            auto tmp = std::move(*l);
+            *l = std::move(*r);
+            for (size_t i = 1; i < num; ++i) {
+                l = leftBase + leftOffsets[i];
+                *r = std::move(*l);
+                r = rightBase - rightOffsets[i];
+                *l = std::move(*r);
+            }
+            *r = std::move(tmp);
+        }
     }
     
-    // Extract elements
-    for (int i = n - 1; i > 0; --i) {
-        std::swap(arr[0], arr[i]);
-        detail::heapify(arr, i, 0, comp);
+    // Same contract as partitionRight below, as a block partition
+    // (BlockQuicksort): each side first records the offsets of up to 64
+    // misplaced elements without branching on the comparisons, then the
+    // recorded elements are swapped pairwise.
+    template <typename RandomIt, typename Compare>
+    std::pair<RandomIt, bool> partitionRightBranchless(RandomIt begin, RandomIt end, Compare comp) {
+        auto pivot = std::move(*begin);
+        RandomIt first = begin;
+        RandomIt last = end;
+        
+        while (comp(*++first, pivot));
+        if (first - 1 == begin) {
+            while (first < last && !comp(*--last, pivot));
+        } else {
+            while (!comp(*--last, pivot));
+        }
+        
+        bool alreadyPartitioned = first >= last;
+        if (!alreadyPartitioned) {
+            std::iter_swap(first, last);
+            ++first;
+            
+            alignas(64) unsigned char leftOffsets[kPartitionBlockSize];
+            alignas(64) unsigned char rightOffsets[kPartitionBlockSize];
+            RandomIt leftBase = first;
+            RandomIt rightBase = last;
+            size_t numLeft = 0, numRight = 0, startLeft = 0, startRight = 0;
+            
+            while (first < last) {
+                // Refill whichever offset blocks ran empty, splitting what is
+                // left between them
+                size_t unknown = static_cast<size_t>(last - first);
+                size_t leftSplit = numLeft == 0 ? (numRight == 0 ? unknown / 2 : unknown) : 0;
+                size_t rightSplit = numRight == 0 ? unknown - leftSplit : 0;
+                
+                size_t leftCount = std::min(leftSplit, kPartitionBlockSize);
+                for (size_t i = 0; i < leftCount; ++i) {
+                    leftOffsets[numLeft] = static_cast<unsigned char>(i);
+                    numLeft += !comp(*first, pivot);
+                    ++first;
+                }
+                size_t rightCount = std::min(rightSplit, kPartitionBlockSize);
+                for (size_t i = 0; i < rightCount; ++i) {
+                    rightOffsets[numRight] = static_cast<unsigned char>(i + 1);
+                    numRight += comp(*--last, pivot);
+                }
+                
+                size_t num = std::min(numLeft, numRight);
+                swapOffsets(leftBase, rightBase, leftOffsets + startLeft, rightOffsets + startRight,
+                            num, numLeft == numRight);
+                numLeft -= num;
+                numRight -= num;
+                startLeft += num;
+                startRight += num;
+                if (numLeft == 0) {
+                    startLeft = 0;
+                    leftBase = first;
+                }
+                if (numRight == 0) {
+                    startRight = 0;
+                    rightBase = last;
+                }
+            }
+            
+            // One side may still hold misplaced elements; move them across
+            // the final boundary
+            if (numLeft) {
+                const unsigned char* offsets = leftOffsets + startLeft;
+                while (numLeft--) std::iter_swap(leftBase + offsets[numLeft], --last);
+                first = last;
+            }
+            if (numRight) {
+                const unsigned char* offsets = rightOffsets + startRight;
+                while (numRight--) std::iter_swap(rightBase - offsets[numRight], first++);
+            }
+        }
+        
+        RandomIt pivotPos = first - 1;
+        *begin = std::move(*pivotPos);
+        *pivotPos = std::move(pivot);
+        return {pivotPos, alreadyPartitioned};
+    }
+    
+    // Same contract as partitionRight below. The scalar scans find the first
+    // misplaced pair (and detect already-partitioned input); the vector
+    // kernel partitions everything between them.
+    template <typename RandomIt, typename Compare>
+    std::pair<RandomIt, bool> partitionRightSimd(RandomIt first, RandomIt last, Compare comp) {
+        auto* base = &*first;
+        auto pivot = base[0];
+        std::ptrdiff_t lo = 0;
+        std::ptrdiff_t hi = last - first;
+        
+        while (comp(base[++lo], pivot));
+        if (lo == 1) {
+            while (lo < hi && !comp(base[--hi], pivot));
+        } else {
+            while (!comp(base[--hi], pivot));
+        }
+        
+        bool alreadyPartitioned = lo >= hi;
+        std::ptrdiff_t mid = lo;
+        if (!alreadyPartitioned) {
+            std::swap(base[lo], base[hi]);
+            mid = simd::partition(base + lo + 1, base + hi, pivot) - base;
+        }
+        
+        std::ptrdiff_t pivotPos = mid - 1;
+        base[0] = base[pivotPos];
+        base[pivotPos] = pivot;
+        return {first + pivotPos, alreadyPartitioned};
+    }
+    
+    // Partition around the pivot *first: elements < pivot go left, the rest
+    // right. Returns the pivot's final position and whether the range was
+    // already partitioned (no swaps needed).
+    template <typename RandomIt, typename Compare>
+    std::pair<RandomIt, bool> partitionRight(RandomIt first, RandomIt last, Compare comp) {
+        if constexpr (simd::accelerated<RandomIt, Compare>()) {
+            if (simd::activeIsa() != simd::Isa::Scalar) return partitionRightSimd(first, last, comp);
+        }
+        if constexpr (isBranchless<IterValue<RandomIt>, Compare>) {
+            return partitionRightBranchless(first, last, comp);
+        }
+        auto pivot = std::move(*first);
+        RandomIt lo = first;
+        RandomIt hi = last;
+        
+        // The median-of-three guarantees these scans stop inside the range
+        while (comp(*++lo, pivot));
+        if (lo - 1 == first) {
+            while (lo < hi && !comp(*--hi, pivot));
+        } else {
+            while (!comp(*--hi, pivot));
+        }
+        
+        bool alreadyPartitioned = lo >= hi;
+        while (lo < hi) {
+            std::iter_swap(lo, hi);
+            note<Compare>(instrument::Counter::Swaps);
+            while (comp(*++lo, pivot));
+            while (!comp(*--hi, pivot));
+        }
+        
+        RandomIt pivotPos = lo - 1;
+        *first = std::move(*pivotPos);
+        *pivotPos = std::move(pivot);
+        note<Compare>(instrument::Counter::Moves, 3);
+        return {pivotPos, alreadyPartitioned};
+    }
+    
+    // Partition for runs of keys equal to the pivot: elements <= pivot go
+    // left. Used when the pivot equals the element just before the range,
+    // so the whole left part is equal and never needs sorting again.
+    template <typename RandomIt, typename Compare>
+    RandomIt partitionLeft(RandomIt first, RandomIt last, Compare comp) {
+        auto pivot = std::move(*first);
+        RandomIt lo = first;
+        RandomIt hi = last;
+        
+        while (comp(pivot, *--hi));
+        if (hi + 1 == last) {
+            while (lo < hi && !comp(pivot, *++lo));
+        } else {
+            while (!comp(pivot, *++lo));
+        }
+        
+        while (lo < hi) {
+            std::iter_swap(lo, hi);
+            note<Compare>(instrument::Counter::Swaps);
+            while (comp(pivot, *--hi));
+            while (!comp(pivot, *++lo));
+        }
+        
+        *first = std::move(*hi);
+        *hi = std::move(pivot);
+        note<Compare>(instrument::Counter::Moves, 3);
+        return hi;
+    }
+    
+    // Shuffle a few elements of an unbalanced partition to break up
+    // patterns that defeat the pivot choice
+    template <typename Compare, typename RandomIt>
+    void breakPatterns(RandomIt first, RandomIt last) {
+        std::ptrdiff_t size = last - first;
+        if (size < kInsertionSortThreshold) return;
+        std::iter_swap(first, first + size / 4);
+        std::iter_swap(last - 1, last - size / 4);
+        if (size > kNintherThreshold) {
+            std::iter_swap(first + 1, first + (size / 4 + 1));
+            std::iter_swap(first + 2, first + (size / 4 + 2));
+            std::iter_swap(last - 2, last - (size / 4 + 1));
+            std::iter_swap(last - 3, last - (size / 4 + 2));
+        }
+        note<Compare>(instrument::Counter::Swaps, size > kNintherThreshold ? 6 : 2);
+    }
+    
+    template <typename RandomIt, typename Compare>
+    void introSortLoop(RandomIt first, RandomIt last, Compare comp,
+                       int badAllowed, bool leftmost) {
+        DepthScope<Compare> depth;
+        while (true) {
+            std::ptrdiff_t size = last - first;
+            if constexpr (simd::accelerated<RandomIt, Compare>()) {
+                // Sorting network for small blocks, when a vector unit exists
+                if (size > 1 && size <= static_cast<std::ptrdiff_t>(simd::kMaxBlock) &&
+                    simd::sortBlock(&*first, static_cast<size_t>(size))) return;
+            }
+            if (size < kInsertionSortThreshold) {
+                if (leftmost) detail::insertionSort(first, last, comp);
+                else unguardedInsertionSort(first, last, comp);
+                return;
+            }
+            
+            // Median-of-three, or Tukey's ninther for large ranges, into *first
+            std::ptrdiff_t half = size / 2;
+            if (size > kNintherThreshold) {
+                sort3(first, first + half, last - 1, comp);
+                sort3(first + 1, first + (half - 1), last - 2, comp);
+                sort3(first + 2, first + (half + 1), last - 3, comp);
+                sort3(first + (half - 1), first + half, first + (half + 1), comp);
+                std::iter_swap(first, first + half);
+                note<Compare>(instrument::Counter::Swaps);
+            } else {
+                sort3(first + half, first, last - 1, comp);
+            }
+            
+            // Pivot equal to its left neighbour: peel off the run of equal keys
+            if (!leftmost && !comp(*(first - 1), *first)) {
+                first = partitionLeft(first, last, comp) + 1;
+                continue;
+            }
+            
+            auto [pivotPos, alreadyPartitioned] = partitionRight(first, last, comp);
+            std::ptrdiff_t leftSize = pivotPos - first;
+            std::ptrdiff_t rightSize = last - (pivotPos + 1);
+            
+            if (leftSize < size / 8 || rightSize < size / 8) {
+                // Too many bad pivots: fall back to heapsort for O(n log n)
+                if (--badAllowed == 0) {
+                    detail::heapSort(first, last, comp);
+                    return;
+                }
+                breakPatterns<Compare>(first, pivotPos);
+                breakPatterns<Compare>(pivotPos + 1, last);
+            } else if (alreadyPartitioned &&
+                       partialInsertionSort(first, pivotPos, comp) &&
+                       partialInsertionSort(pivotPos + 1, last, comp)) {
+                // Nearly sorted input finishes in linear time
+                return;
+            }
+            
+            // Recurse into the smaller side and loop on the larger one
+            if (leftSize < rightSize) {
+                introSortLoop(first, pivotPos, comp, badAllowed, leftmost);
+                first = pivotPos + 1;
+                leftmost = false;
+            } else {
+                introSortLoop(pivotPos + 1, last, comp, badAllowed, false);
+                last = pivotPos;
+            }
+        }
+    }
+    
+    template <typename RandomIt, typename Compare>
+    void introSort(RandomIt first, RandomIt last, Compare comp) {
+        std::ptrdiff_t n = last - first;
+        if (n < 2) return;
+        if constexpr (simd::accelerated<RandomIt, Compare>()) {
+            // The scalar swap loop turns descending input into two sorted
+            // halves; the vector partition does not, so catch it up front
+            if (std::is_sorted(first, last, [&comp](const auto& a, const auto& b) { return comp(b, a); })) {
+                std::reverse(first, last);
+                return;
+            }
+        }
+        int log2n = 0;
+        while (n >>= 1) ++log2n;
+        introSortLoop(first, last, comp, log2n, true);
     }
 }
 
-// Utility: Check if array is sorted
+template <typename RandomIt, typename Compare = std::less<detail::IterValue<RandomIt>>>
+void introSort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    detail::SortTimer<Compare> timer(instrument::Operation::Sort);
+    detail::introSort(first, last, comp);
+}
+
 template <typename T, typename Compare = std::less<T>>
-bool isSorted(const std::vector<T>& arr, Compare comp = Compare()) {
-    for (size_t i = 1; i < arr.size(); ++i) {
-        if (comp(arr[i], arr[i - 1])) return false;
+void introSort(std::vector<T>& arr, Compare comp = Compare()) {
+    introSort(arr.begin(), arr.end(), comp);
+}
+
+// Small fixed-size arrays of arithmetic keys take the sorting network
+template <typename Range, detail::EnableIfRange<Range> = 0,
+          typename Compare = std::less<detail::RangeValue<Range>>>
+void introSort(Range&& range, Compare comp = Compare()) {
+    if constexpr (detail::hasSmallStaticExtent<Range> &&
+                  detail::isBranchless<detail::RangeValue<Range>, Compare>) {
+        staticSort<detail::staticExtent<Range>>(std::begin(range), comp);
+    } else {
+        introSort(std::begin(range), std::end(range), comp);
+    }
+}
+
+// Quick Sort - O(n log n); backed by the introsort engine so sorted,
+// reversed and duplicate-heavy inputs no longer degrade to O(n^2)
+template <typename RandomIt, typename Compare = std::less<detail::IterValue<RandomIt>>>
+void quickSort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    detail::SortTimer<Compare> timer(instrument::Operation::Sort);
+    detail::introSort(first, last, comp);
+}
+
+template <typename T, typename Compare = std::less<T>>
+void quickSort(std::vector<T>& arr, Compare comp = Compare()) {
+    quickSort(arr.begin(), arr.end(), comp);
+}
+
+// Small fixed-size arrays of arithmetic keys take the sorting network
+template <typename Range, detail::EnableIfRange<Range> = 0,
+          typename Compare = std::less<detail::RangeValue<Range>>>
+void quickSort(Range&& range, Compare comp = Compare()) {
+    if constexpr (detail::hasSmallStaticExtent<Range> &&
+                  detail::isBranchless<detail::RangeValue<Range>, Compare>) {
+        staticSort<detail::staticExtent<Range>>(std::begin(range), comp);
+    } else {
+        quickSort(std::begin(range), std::end(range), comp);
+    }
+}
+
+// Utility: Check if array is sorted
+template <typename ForwardIt, typename Compare = std::less<detail::IterValue<ForwardIt>>>
+bool isSorted(ForwardIt first, ForwardIt last, Compare comp = Compare()) {
+    if (first == last) return true;
+    for (ForwardIt prev = first++; first != last; prev = first++) {
+        if (comp(*first, *prev)) return false;
     }
     return true;
 }
 
+template <typename T, typename Compare = std::less<T>>
+bool isSorted(const std::vector<T>& arr, Compare comp = Compare()) {
+    return isSorted(arr.begin(), arr.end(), comp);
+}
+
+template <typename Range, detail::EnableIfRange<Range> = 0,
+          typename Compare = std::less<detail::RangeValue<Range>>>
+bool isSorted(const Range& range, Compare comp = Compare()) {
+    return isSorted(std::begin(range), std::end(range), comp);
+}
+
 } // namespace sort
 } // namespace dsa
@@ -0,0 +1,298 @@
+#pragma once
+
+/**
+ * @file StaticSearchTree.hpp
+ * @brief Immutable, cache-friendly search tree over a sorted key set
+ * @author Neel Patel
+ * @version 1.0.0
+ *
+ * Features:
+ * - Eytzinger (BFS order) layout: node k has children 2k and 2k+1, so the
+ *   first levels of every search share the same few cache lines
+ * - Branchless descent with software prefetch several levels ahead
+ * - contains, lower_bound, upper_bound and rank in O(log n)
+ * - Sorted random-access view (begin/end, operator[]) next to the layout
+ * - save() writes the layout to disk; map() queries such a file in place,
+ *   without reading or rebuilding it
+ *
+ * Built once from the keys (e.g. BinarySearchTree::freeze()), then read-only;
+ * concurrent readers need no synchronization. Copies share the layout.
+ */
+
+#include "MappedFile.hpp"
+#include "Serialization.hpp"
+#include "Sorting.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace dsa {
+
+namespace detail {
+    constexpr size_t kCacheLineSize = 64;
+    
+    // Allocator handing out cache-line aligned storage
+    template <typename T>
+    struct CacheAlignedAllocator {
+        using value_type = T;
+        
+        CacheAlignedAllocator() = default;
+        template <typename U>
+        CacheAlignedAllocator(const CacheAlignedAllocator<U>&) noexcept {}
+        
+        [[nodiscard]] T* allocate(size_t n) {
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(kCacheLineSize)));
+        }
+        
+        void deallocate(T* p, size_t) noexcept {
+            ::operator delete(p, std::align_val_t(kCacheLineSize));
+        }
+        
+        template <typename U>
+        friend bool operator==(const CacheAlignedAllocator&, const CacheAlignedAllocator<U>&) { return true; }
+        template <typename U>
+        friend bool operator!=(const CacheAlignedAllocator&, const CacheAlignedAllocator<U>&) { return false; }
+    };
+    
+    // Undo the trailing "go right" steps of an Eytzinger descent, plus one
+    // more: what is left is the last node where the search went left
+    inline size_t eytzingerRetreat(size_t k) {
+#if defined(__GNUC__)
+        return k >> (__builtin_ctzll(~static_cast<unsigned long long>(k)) + 1);
+#else
+        while (k & 1) k >>= 1;
+        return k >> 1;
+#endif
+    }
+    
+    // Prefetch hint only: the address may lie past the array, so it is
+    // formed as an integer rather than by pointer arithmetic
+    inline void prefetchAddress(uintptr_t address) {
+#if defined(__GNUC__)
+        __builtin_prefetch(reinterpret_cast<const void*>(address));
+#else
+        (void)address;
+#endif
+    }
+}
+
+template <typename T>
+class StaticSearchTree {
+public:
+    using value_type = T;
+    using const_iterator = const T*;
+    using iterator = const_iterator;
+    
+    StaticSearchTree() = default;
+    
+    // Keys in any order; duplicates are kept once
+    explicit StaticSearchTree(std::vector<T> keys) {
+        auto strictlyIncreasing = [&keys] {
+            for (size_t i = 1; i < keys.size(); ++i) {
+                if (!(keys[i - 1] < keys[i])) return false;
+            }
+            return true;
+        };
+        if (!strictlyIncreasing()) {
+            sort::quickSort(keys);
+            keys.erase(std::unique(keys.begin(), keys.end(),
+                                   [](const T& a, const T& b) { return !(a < b); }),
+                       keys.end());
+        }
+        build(std::move(keys));
+    }
+    
+    template <typename InputIt>
+    StaticSearchTree(InputIt first, InputIt last) : StaticSearchTree(std::vector<T>(first, last)) {}
+    
+    StaticSearchTree(std::initializer_list<T> init) : StaticSearchTree(std::vector<T>(init)) {}
+    
+    // The layout is immutable, so copies share it: O(1)
+    StaticSearchTree(const StaticSearchTree&) = default;
+    StaticSearchTree& operator=(const StaticSearchTree&) = default;
+    
+    StaticSearchTree(StaticSearchTree&& other) noexcept { swap(other); }
+    
+    StaticSearchTree& operator=(StaticSearchTree&& other) noexcept {
+        StaticSearchTree(std::move(other)).swap(*this);
+        return *this;
+    }
+    
+    void swap(StaticSearchTree& other) noexcept {
+        std::swap(keys_, other.keys_);
+        std::swap(tree_, other.tree_);
+        std::swap(order_, other.order_);
+        std::swap(size_, other.size_);
+        storage_.swap(other.storage_);
+    }
+    
+    // Write the keys and the Eytzinger layout (io::Layout::Eytzinger)
+    void save(const std::filesystem::path& path) const {
+        io::FileHeader header = io::detail::makeHeader<T>(io::Layout::Eytzinger, size_);
+        io::detail::Sections<T> sections(size_, io::Layout::Eytzinger);
+        io::detail::FileWriter out(path);
+        out.write(&header, sizeof(header));
+        if (size_ > 0) {
+            out.write(keys_, size_ * sizeof(T));
+            out.seek(sections.tree);
+            out.write(tree_, (size_ + 1) * sizeof(T));
+            out.seek(sections.order);
+            out.write(order_, (size_ + 1) * sizeof(uint64_t));
+        }
+        out.close();
+    }
+    
+    // Read a file written by save() or BinarySearchTree::save() into memory.
+    // Only the sorted keys are read; the layout is rebuilt from them.
+    static StaticSearchTree load(const std::filesystem::path& path) {
+        std::vector<T> keys =
+            io::detail::loadElements<T>(path, {io::Layout::SortedKeys, io::Layout::Eytzinger});
+        for (size_t i = 1; i < keys.size(); ++i) {
+            if (!(keys[i - 1] < keys[i])) {
+                throw std::runtime_error(path.string() + ": keys are not strictly increasing");
+            }
+        }
+        StaticSearchTree result;
+        result.build(std::move(keys));
+        return result;
+    }
+    
+    // Zero-copy: map a file written by save() and search it in place. Pages
+    // are read on first touch and the mapping lives as long as any copy.
+    // Only the header is validated, so the file must come from a trusted
+    // writer. Falls back to load() where mmap is unavailable.
+    static StaticSearchTree map(const std::filesystem::path& path) {
+#if defined(DSA_HAS_MMAP)
+        auto file = std::make_shared<MappedFile>(path, MappedFile::Mode::Read);
+        io::FileHeader header{};
+        if (file->size() >= sizeof(header)) std::memcpy(&header, file->data(), sizeof(header));
+        io::detail::checkHeader<T>(header, file->size(), {io::Layout::Eytzinger}, path);
+        
+        StaticSearchTree result;
+        size_t n = static_cast<size_t>(header.count);
+        if (n > 0) {
+            io::detail::Sections<T> sections(n, io::Layout::Eytzinger);
+            const std::byte* base = file->data();
+            result.keys_ = reinterpret_cast<const T*>(base + sections.keys);
+            result.tree_ = reinterpret_cast<const T*>(base + sections.tree);
+            result.order_ = reinterpret_cast<const uint64_t*>(base + sections.order);
+            result.size_ = n;
+            result.storage_ = std::move(file);
+        }
+        return result;
+#else
+        return load(path);
+#endif
+    }
+    
+    // Capacity
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+    [[nodiscard]] size_t size() const { return size_; }
+    
+    // Sorted view
+    [[nodiscard]] const_iterator begin() const { return keys_; }
+    [[nodiscard]] const_iterator end() const { return keys_ + size_; }
+    [[nodiscard]] const T& operator[](size_t k) const { return keys_[k]; }
+    
+    // Lookup
+    [[nodiscard]] bool contains(const T& value) const {
+        size_t k = descend(value, [](const T& node, const T& v) { return node < v; });
+        return k != 0 && !(value < tree_[k]);
+    }
+    
+    // First key >= value
+    [[nodiscard]] const_iterator lower_bound(const T& value) const {
+        return toIterator(descend(value, [](const T& node, const T& v) { return node < v; }));
+    }
+    
+    // First key > value
+    [[nodiscard]] const_iterator upper_bound(const T& value) const {
+        return toIterator(descend(value, [](const T& node, const T& v) { return !(v < node); }));
+    }
+    
+    [[nodiscard]] const_iterator find(const T& value) const {
+        const_iterator it = lower_bound(value);
+        return it != end() && !(value < *it) ? it : end();
+    }
+    
+    // Number of keys strictly less than value
+    [[nodiscard]] size_t rank(const T& value) const {
+        return static_cast<size_t>(lower_bound(value) - begin());
+    }
+
+private:
+    // In-memory layout; a mapped tree holds a MappedFile instead
+    struct Storage {
+        std::vector<T> keys;                                    // sorted
+        std::vector<T, detail::CacheAlignedAllocator<T>> tree;  // Eytzinger, slot 0 unused
+        std::vector<uint64_t> order;                            // Eytzinger slot -> sorted index
+    };
+    
+    // Prefetch the node 4 levels down (16 descendants of k, one cache line
+    // for 4-byte keys); deeper for smaller keys, shallower for larger ones
+    static constexpr size_t kPrefetchStride =
+        std::max<size_t>(detail::kCacheLineSize / sizeof(T), 1);
+    
+    // Fill the 1-based Eytzinger array from the sorted keys by an in-order
+    // walk of the implicit tree; recursion depth is log2(n)
+    static size_t place(Storage& s, size_t i, size_t k) {
+        if (k <= s.keys.size()) {
+            i = place(s, i, 2 * k);
+            s.tree[k] = s.keys[i];
+            s.order[k] = i++;
+            i = place(s, i, 2 * k + 1);
+        }
+        return i;
+    }
+    
+    // Lay out strictly increasing keys
+    void build(std::vector<T> keys) {
+        if (keys.empty()) return;
+        auto storage = std::make_shared<Storage>();
+        storage->keys = std::move(keys);
+        storage->tree.assign(storage->keys.size() + 1, T());
+        storage->order.assign(storage->keys.size() + 1, 0);
+        place(*storage, 0, 1);
+        keys_ = storage->keys.data();
+        tree_ = storage->tree.data();
+        order_ = storage->order.data();
+        size_ = storage->keys.size();
+        storage_ = std::move(storage);
+    }
+    
+    // Branchless walk: go right while goRight(node, value). Returns the
+    // Eytzinger index of the first node where it went left, 0 if none.
+    template <typename GoRight>
+    size_t descend(const T& value, GoRight goRight) const {
+        const T* tree = tree_;
+        size_t n = size_;
+        size_t k = 1;
+        while (k <= n) {
+            detail::prefetchAddress(reinterpret_cast<uintptr_t>(tree) + k * kPrefetchStride * sizeof(T));
+            k = 2 * k + static_cast<size_t>(goRight(tree[k], value));
+        }
+        return detail::eytzingerRetreat(k);
+    }
+    
+    const_iterator toIterator(size_t k) const {
+        return k == 0 ? end() : keys_ + order_[k];
+    }
+    
+    // Views into storage_, which owns (or maps) the memory behind them
+    const T* keys_ = nullptr;       // sorted
+    const T* tree_ = nullptr;       // Eytzinger, slot 0 unused
+    const uint64_t* order_ = nullptr;
+    size_t size_ = 0;
+    std::shared_ptr<const void> storage_;
+};
+
+} // namespace dsa
@@ -0,0 +1,249 @@
+#pragma once
+
+/**
+ * @file ThreadPool.hpp
+ * @brief Work-stealing thread pool with fork-join task groups in C++17
+ * @author Neel Patel
+ * @version 1.0.0
+ *
+ * Features:
+ * - One task deque per worker: owners pop LIFO, thieves steal FIFO
+ * - TaskGroup fork-join: waiting threads run pending tasks instead of
+ *   blocking, so nested parallelism cannot deadlock the pool
+ * - Exceptions thrown by tasks are rethrown from TaskGroup::wait()
+ * - parallelFor helper and execution policies (dsa::execution::seq/par)
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace dsa {
+
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+    
+    explicit ThreadPool(size_t threads = std::max(1u, std::thread::hardware_concurrency())) {
+        queues_.reserve(threads + 1);
+        for (size_t i = 0; i <= threads; ++i) queues_.push_back(std::make_unique<Queue>());
+        workers_.reserve(threads);
+        for (size_t i = 0; i < threads; ++i) {
+            workers_.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    // Runs every task still queued, then joins the workers
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            stop_ = true;
+        }
+        sleepCv_.notify_all();
+        for (auto& worker : workers_) worker.join();
+    }
+    
+    // Process-wide pool sized to the hardware
+    static ThreadPool& global() {
+        static ThreadPool pool;
+        return pool;
+    }
+    
+    [[nodiscard]] size_t size() const { return workers_.size(); }
+    
+    // Fire-and-forget; use TaskGroup to wait for completion
+    void submit(Task task) {
+        // Workers push onto their own deque; other threads use the shared one
+        size_t slot = isWorker() ? current().index : injectionSlot();
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(queues_[slot]->mutex);
+            queues_[slot]->tasks.push_back(std::move(task));
+        }
+        {
+            // Pairs with the predicate check in workerLoop to avoid lost wake-ups
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+        }
+        sleepCv_.notify_one();
+    }
+    
+    // Execute one queued task on the calling thread, if any is available
+    bool tryRunOne() {
+        Task task;
+        if (!takeTask(isWorker() ? current().index : injectionSlot(), task)) return false;
+        task();
+        return true;
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+    
+    struct ThreadState {
+        const ThreadPool* pool = nullptr;
+        size_t index = 0;
+    };
+    
+    static ThreadState& current() {
+        static thread_local ThreadState state;
+        return state;
+    }
+    
+    bool isWorker() const { return current().pool == this; }
+    size_t injectionSlot() const { return workers_.size(); }
+    
+    // Own queue from the back (hot in cache), then steal from the front of others
+    bool takeTask(size_t self, Task& task) {
+        if (pending_.load(std::memory_order_acquire) == 0) return false;
+        {
+            Queue& own = *queues_[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                pending_.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        for (size_t offset = 1; offset < queues_.size(); ++offset) {
+            Queue& victim = *queues_[(self + offset) % queues_.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                pending_.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    void workerLoop(size_t index) {
+        current() = {this, index};
+        while (true) {
+            Task task;
+            if (takeTask(index, task)) {
+                task();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            if (stop_ && pending_.load(std::memory_order_acquire) == 0) return;
+            sleepCv_.wait(lock, [this] {
+                return stop_ || pending_.load(std::memory_order_acquire) > 0;
+            });
+        }
+    }
+    
+    std::vector<std::unique_ptr<Queue>> queues_; // one per worker + injection queue
+    std::vector<std::thread> workers_;
+    std::atomic<size_t> pending_{0};
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCv_;
+    bool stop_ = false;
+};
+
+// Fork-join scope: run() spawns, wait() joins. Waiting threads help execute
+// queued work, so a task may itself create and wait on a TaskGroup.
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool& pool = ThreadPool::global()) : pool_(pool) {}
+    
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+    
+    ~TaskGroup() { join(); }
+    
+    template <typename F>
+    void run(F&& f) {
+        outstanding_.fetch_add(1, std::memory_order_relaxed);
+        pool_.submit([this, fn = std::forward<F>(f)]() mutable {
+            try {
+                fn();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex_);
+                if (!error_) error_ = std::current_exception();
+            }
+            outstanding_.fetch_sub(1, std::memory_order_release);
+        });
+    }
+    
+    // Block until every spawned task finished; rethrows the first failure
+    void wait() {
+        join();
+        if (error_) std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+    
+    [[nodiscard]] ThreadPool& pool() const { return pool_; }
+
+private:
+    void join() {
+        while (outstanding_.load(std::memory_order_acquire) != 0) {
+            if (!pool_.tryRunOne()) std::this_thread::yield();
+        }
+    }
+    
+    ThreadPool& pool_;
+    std::atomic<size_t> outstanding_{0};
+    std::mutex errorMutex_;
+    std::exception_ptr error_;
+};
+
+// Call body(lo, hi) over [begin, end) split into chunks of about `grain`
+template <typename Body>
+void parallelFor(ThreadPool& pool, size_t begin, size_t end, size_t grain, Body body) {
+    grain = std::max<size_t>(grain, 1);
+    TaskGroup group(pool);
+    for (size_t lo = begin; lo < end; lo += grain) {
+        size_t hi = std::min(end, lo + grain);
+        if (hi == end) body(lo, hi); // last chunk on the calling thread
+        else group.run([&body, lo, hi] { body(lo, hi); });
+    }
+    group.wait();
+}
+
+// Execution policies for the parallel algorithm overloads
+namespace execution {
+    struct sequenced_policy {};
+    
+    struct parallel_policy {
+        // Below this many elements work is done sequentially
+        size_t grainSize = size_t(1) << 14;
+        // Pool to run on; nullptr means ThreadPool::global()
+        ThreadPool* threadPool = nullptr;
+        
+        [[nodiscard]] constexpr parallel_policy grain(size_t elements) const {
+            parallel_policy policy = *this;
+            policy.grainSize = elements;
+            return policy;
+        }
+        
+        [[nodiscard]] parallel_policy on(ThreadPool& pool) const {
+            parallel_policy policy = *this;
+            policy.threadPool = &pool;
+            return policy;
+        }
+        
+        [[nodiscard]] ThreadPool& pool() const {
+            return threadPool ? *threadPool : ThreadPool::global();
+        }
+    };
+    
+    inline constexpr sequenced_policy seq{};
+    inline constexpr parallel_policy par{};
+}
+
+} // namespace dsa
@@ -0,0 +1,310 @@
+/**
+ * @file Stress.cpp
+ * @brief Multi-threaded stress runs for the lock-free containers
+ * @author Neel Patel
+ * @version 1.0.0
+ *
+ * Meant to be built with -DDSA_SANITIZE=thread so ThreadSanitizer checks
+ * every interleaving the runs hit; without it they still check results.
+ *
+ * - queue: 4 producers and 4 consumers through one ConcurrentQueue, half of
+ *   them through push_bulk / pop_bulk. Every value arrives exactly once and
+ *   each producer's values arrive in order.
+ * - queue teardown: short rounds of a pmr::ConcurrentQueue over its own
+ *   memory resource. Once the queue is destroyed, every byte must be back
+ *   in the resource, even with nodes still in other threads' retire lists.
+ * - tree: 4 threads mixing insert, remove, contains, lower_bound and
+ *   snapshot on one ConcurrentSearchTree. Each thread owns the keys equal
+ *   to its index mod 4 and tracks them, so every lookup of its own keys
+ *   and the final contents have an exact expected answer.
+ * - tree clear: 3 writers race one thread calling clear(). Afterwards size()
+ *   must match the contents.
+ * - persistent: 4 threads each update their own snapshot of one shared
+ *   PersistentSearchTree, so copy-on-write must never touch a node the
+ *   other versions still share. The base version must come out unchanged.
+ *
+ * Usage: dsa_stress [scale], where scale multiplies the operation counts
+ * (default 1). Exits non-zero on the first wrong answer.
+ */
+
+#include "dsa/ConcurrentQueue.hpp"
+#include "dsa/ConcurrentSearchTree.hpp"
+#include "dsa/PersistentSearchTree.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory_resource>
+#include <optional>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int kThreads = 4;
+
+std::atomic<bool> failed{false};
+
+void check(bool condition, const char* what) {
+    if (!condition && !failed.exchange(true)) std::cerr << "FAILED: " << what << std::endl;
+}
+
+// Values carry (producer, sequence) so consumers can check per-producer order
+void stressQueue(size_t perProducer) {
+    dsa::ConcurrentQueue<uint64_t> queue;
+    std::atomic<size_t> consumed{0};
+    const size_t total = perProducer * kThreads;
+    std::vector<std::vector<uint32_t>> seen(kThreads, std::vector<uint32_t>(perProducer, 0));
+    
+    std::vector<std::thread> threads;
+    for (int p = 0; p < kThreads; ++p) {
+        threads.emplace_back([&queue, p, perProducer] {
+            std::vector<uint64_t> batch;
+            for (size_t i = 0; i < perProducer; ++i) {
+                uint64_t value = (uint64_t(p) << 32) | i;
+                if (p % 2 == 0) {
+                    queue.push(value);
+                    continue;
+                }
+                batch.push_back(value);
+                if (batch.size() == 16 || i + 1 == perProducer) {
+                    queue.push_bulk(batch.begin(), batch.end());
+                    batch.clear();
+                }
+            }
+        });
+    }
+    for (int c = 0; c < kThreads; ++c) {
+        threads.emplace_back([&, c] {
+            // Per consumer, values of one producer arrive in increasing order
+            std::vector<int64_t> last(kThreads, -1);
+            std::vector<uint64_t> buffer(16);
+            auto accept = [&](uint64_t value) {
+                size_t producer = value >> 32;
+                size_t sequence = value & 0xffffffff;
+                check(producer < kThreads && sequence < perProducer, "queue value out of range");
+                if (failed) return;
+                check(static_cast<int64_t>(sequence) > last[producer], "queue reordered a producer's values");
+                last[producer] = static_cast<int64_t>(sequence);
+                ++seen[producer][sequence];
+            };
+            while (consumed.load(std::memory_order_relaxed) < total && !failed) {
+                size_t count = 0;
+                if (c % 2 == 0) {
+                    uint64_t value;
+                    if (queue.try_pop(value)) {
+                        accept(value);
+                        count = 1;
+                    }
+                } else {
+                    count = queue.pop_bulk(buffer.begin(), buffer.size());
+                    for (size_t i = 0; i < count; ++i) accept(buffer[i]);
+                }
+                if (count == 0) std::this_thread::yield();
+                consumed.fetch_add(count, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    
+    check(consumed.load() == total, "queue lost or duplicated values");
+    check(queue.empty(), "queue not empty after draining");
+    for (const auto& producer : seen) {
+        check(std::all_of(producer.begin(), producer.end(), [](uint32_t n) { return n == 1; }),
+              "queue value not delivered exactly once");
+    }
+}
+
+// Forwards to new/delete and counts the bytes still allocated
+class CountingResource : public std::pmr::memory_resource {
+public:
+    size_t outstanding() const { return outstanding_.load(); }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        outstanding_ += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        outstanding_ -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+private:
+    std::atomic<size_t> outstanding_{0};
+};
+
+void stressQueueTeardown(size_t opsPerThread) {
+    constexpr size_t kRoundOps = 1024;
+    for (size_t round = 0; round * kRoundOps < opsPerThread && !failed; ++round) {
+        auto resource = std::make_unique<CountingResource>();
+        {
+            dsa::pmr::ConcurrentQueue<uint64_t> queue(resource.get());
+            std::vector<std::thread> threads;
+            for (int t = 0; t < kThreads; ++t) {
+                threads.emplace_back([&queue] {
+                    uint64_t value;
+                    for (size_t i = 0; i < kRoundOps; ++i) {
+                        queue.push(i);
+                        check(queue.try_pop(value), "queue teardown pop found nothing");
+                    }
+                });
+            }
+            for (auto& t : threads) t.join();
+        }
+        check(resource->outstanding() == 0, "queue teardown left nodes allocated");
+    }
+}
+
+void stressTree(size_t opsPerThread) {
+    constexpr int kKeys = 1024;
+    dsa::ConcurrentSearchTree<int> tree;
+    std::vector<std::vector<bool>> owned(kThreads, std::vector<bool>(kKeys, false));
+    
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            std::mt19937 rng(static_cast<uint32_t>(t + 1));
+            std::vector<bool>& mine = owned[t];
+            for (size_t i = 0; i < opsPerThread && !failed; ++i) {
+                int key = static_cast<int>(rng() % (kKeys / kThreads)) * kThreads + t;
+                switch (rng() % 8) {
+                    case 0:
+                    case 1:
+                        check(tree.insert(key) == !mine[key], "tree insert result");
+                        mine[key] = true;
+                        break;
+                    case 2:
+                    case 3:
+                        check(tree.remove(key) == mine[key], "tree remove result");
+                        mine[key] = false;
+                        break;
+                    case 4:
+                    case 5:
+                        check(tree.contains(key) == mine[key], "tree contains result");
+                        break;
+                    case 6: {
+                        // Another thread's key: only the answer's shape is known
+                        std::optional<int> found = tree.lower_bound(static_cast<int>(rng() % kKeys));
+                        check(!found || (*found >= 0 && *found < kKeys), "tree lower_bound out of range");
+                        break;
+                    }
+                    default: {
+                        if (i % 64 != 7) break;
+                        std::vector<int> keys = tree.snapshot();
+                        check(std::adjacent_find(keys.begin(), keys.end(), std::greater_equal<int>()) == keys.end(),
+                              "tree snapshot not strictly increasing");
+                        break;
+                    }
+                }
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    
+    std::vector<int> expected;
+    for (int key = 0; key < kKeys; ++key) {
+        if (owned[key % kThreads][key]) expected.push_back(key);
+    }
+    check(tree.snapshot() == expected, "tree contents differ from the owners' records");
+    check(tree.size() == expected.size(), "tree size differs from its contents");
+}
+
+void stressTreeClear(size_t opsPerThread) {
+    constexpr size_t kRoundOps = 2048;
+    for (size_t round = 0; round * kRoundOps < opsPerThread && !failed; ++round) {
+        dsa::ConcurrentSearchTree<int> tree;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads - 1; ++t) {
+            threads.emplace_back([&tree, round, t] {
+                std::mt19937 rng(static_cast<uint32_t>(round * kThreads + t + 1));
+                for (size_t i = 0; i < kRoundOps; ++i) {
+                    int key = static_cast<int>(rng() % 512);
+                    if (rng() % 2) tree.insert(key);
+                    else tree.remove(key);
+                }
+            });
+        }
+        threads.emplace_back([&tree] {
+            for (int i = 0; i < 64; ++i) tree.clear();
+        });
+        for (auto& t : threads) t.join();
+        check(tree.size() == tree.snapshot().size(), "tree size differs from its contents after clear");
+    }
+}
+
+// Short rounds from fresh snapshots, so the versions keep sharing nodes
+void stressPersistent(size_t opsPerThread) {
+    constexpr int kKeys = 1024;
+    constexpr size_t kRoundOps = 256;
+    std::vector<int> evens;
+    for (int key = 0; key < kKeys; key += 2) evens.push_back(key);
+    const dsa::PersistentSearchTree<int> base = dsa::PersistentSearchTree<int>::fromSorted(evens.begin(), evens.end());
+    
+    for (size_t round = 0; round * kRoundOps < opsPerThread && !failed; ++round) {
+        // Taking a snapshot needs exclusive access, so it happens between rounds
+        std::vector<dsa::PersistentSearchTree<int>> versions;
+        for (int t = 0; t < kThreads; ++t) versions.push_back(base.snapshot());
+        
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; ++t) {
+            threads.emplace_back([&, t] {
+                std::mt19937 rng(static_cast<uint32_t>(round * kThreads + t + 1));
+                dsa::PersistentSearchTree<int>& version = versions[t];
+                std::vector<bool> present(kKeys, false);
+                for (int key : evens) present[key] = true;
+                for (size_t i = 0; i < kRoundOps && !failed; ++i) {
+                    int key = static_cast<int>(rng() % kKeys);
+                    switch (rng() % 3) {
+                        case 0:
+                            check(version.insert(key) == !present[key], "persistent insert result");
+                            present[key] = true;
+                            break;
+                        case 1:
+                            check(version.remove(key) == present[key], "persistent remove result");
+                            present[key] = false;
+                            break;
+                        default:
+                            check(version.contains(key) == present[key], "persistent contains result");
+                            break;
+                    }
+                }
+                std::vector<int> expected;
+                for (int key = 0; key < kKeys; ++key) {
+                    if (present[key]) expected.push_back(key);
+                }
+                check(version.inorderTraversal() == expected, "persistent version contents");
+            });
+        }
+        for (auto& t : threads) t.join();
+    }
+    check(base.inorderTraversal() == evens, "persistent base version changed");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t scale = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1;
+    if (scale == 0) scale = 1;
+    
+    stressQueue(scale * 50000);
+    std::cout << "queue: " << (failed ? "FAILED" : "ok") << std::endl;
+    stressQueueTeardown(scale * 50000);
+    std::cout << "queue teardown: " << (failed ? "FAILED" : "ok") << std::endl;
+    stressTree(scale * 50000);
+    std::cout << "tree: " << (failed ? "FAILED" : "ok") << std::endl;
+    stressTreeClear(scale * 50000);
+    std::cout << "tree clear: " << (failed ? "FAILED" : "ok") << std::endl;
+    stressPersistent(scale * 50000);
+    std::cout << "persistent: " << (failed ? "FAILED" : "ok") << std::endl;
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}